@@ -1,6 +1,6 @@
 cd src || exit
-bison -d -t -y parser.y  || exit
+bison -d -t -o y.tab.c parser.y || exit
 mv y.tab.c y.tab.cpp || exit
 gcc -O -I../picosat-957 ../picosat-957/picosat.c -c -o picosat.o || exit
-g++ -O -std=c++11 -I../picosat-957 picosat.o abstractSatisfiabilityChecker.cpp formulaFactory.cpp satChecker.cpp main.cpp y.tab.cpp lex.yy.cc -o itlsc || exit
+g++ -O -std=c++11 -pthread -I../picosat-957 picosat.o abstractSatisfiabilityChecker.cpp symmetryDetector.cpp certificateValidator.cpp icnfWriter.cpp resultCache.cpp formulaFactory.cpp itlsat.cpp satChecker.cpp portfolioChecker.cpp batchChecker.cpp server.cpp threadPool.cpp satSolver.cpp main.cpp y.tab.cpp lex.yy.cc -ldl -lz -o itlsc || exit
 echo "ITLSC has been successfully built."
@@ -23,6 +23,8 @@ for line in allfiles:
                 satLength = a[71:].strip()
             if a.startswith("Result: Aborting due to reaching the maximum bound"):
                 satLength = "unsat"
+            if a.startswith("Result: The temporal logic formula is unsatisfiable"):
+                satLength = "unsat"
         p.stdout.close()    
         if satLength==None:
             print >>sys.stderr, "Error: Could not find satisfiability result when running 'itlsc' for input file "+line
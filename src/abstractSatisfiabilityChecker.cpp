@@ -1,187 +1,577 @@
 #include "abstractSatisfiabilityChecker.hpp"
 #include "formulaFactory.hpp"
+#include <cassert>
 
-ThreeValueBool ThreeValueBool::FALSE(3);
-ThreeValueBool ThreeValueBool::TRUE(2);
-ThreeValueBool ThreeValueBool::X(1);
+ThreeValueBool ThreeValueBool::FALSE(2);
+ThreeValueBool ThreeValueBool::TRUE(1);
+ThreeValueBool ThreeValueBool::X(3);
 ThreeValueBool ThreeValueBool::UNINITIALISED(0);
 
-const int ThreeValueBool::threeValueBoolCombinationTableAND[] = {0,0,0,0, 0,1,1,3, 0,1,2,3, 0,3,3,3};
-const int ThreeValueBool::threeValueBoolCombinationTableOR[] = {0,0,0,0, 0,1,2,1, 0,2,2,2, 0,1,2,3};
-const int ThreeValueBool::threeValueBoolCombinationTableNOT[] = {0,1,3,2};
+AbstractSatisfiabilityChecker::AbstractSatisfiabilityChecker(const FormulaFactory &factory, int _mainFormula) : mainFormula(_mainFormula), wordLength(0) {
+    nodes.resize(factory.getNofFormulas());
+    for (unsigned int subformula=0;subformula<factory.getNofFormulas();subformula++) {
+        Node &node = nodes[subformula];
+        node.type = factory.getFormulaType(subformula);
+        FormulaChildren params = factory.getChildren(subformula);
+        node.children.assign(params.begin(),params.end());
+        node.child = 0;
+        node.partner = -1;
+        node.isContradiction = false;
+        node.isTautology = false;
+        if ((node.type!=TF_AND) && (node.type!=TF_OR)) {
+            node.child = factory.getSingleParameterOfTemporalSubformula(subformula);
+        }
+
+        switch (node.type) {
+        case TF_AND:
+        case TF_OR:
+            /* Special Case: Conjunction/Disjunction between an atomic proposition and its negation
+             * -> Detect the encoding of "FALSE" and "TRUE"
+             */
+            for (auto it = params.begin();it!=params.end();it++) {
+                if ((*it>=0) && (factory.getFormulaType(*it)==TF_NOT) && (params.count(factory.getSingleParameterOfTemporalSubformula(*it))>0)) {
+                    if (node.type==TF_AND) node.isContradiction = true; else node.isTautology = true;
+                }
+            }
+            break;
+        case TF_NOT:
+            if (node.child>=0) throw std::string("TF_NOT may only be applied to atomic propositions!");
+            break;
+        case TF_DIAMOND_A:
+        case TF_DIAMOND_A_BAR:
+        case TF_DIAMOND_L:
+        case TF_DIAMOND_L_BAR:
+        case TF_DIAMOND_O:
+        case TF_DIAMOND_O_BAR:
+        case TF_BOX_A:
+        case TF_BOX_A_BAR:
+        case TF_BOX_L:
+        case TF_BOX_L_BAR:
+        case TF_BOX_O:
+        case TF_BOX_O_BAR:
+            {
+                FormulaType partnerType;
+                FormulaFactory::getEncodingPartnerType(node.type,partnerType);
+                node.partner = factory.findSubformula(partnerType,params);
+                assert(node.partner!=FormulaFactory::NO_SUBFORMULA);
+            }
+            break;
+        case TF_DIAMOND_B:
+        case TF_DIAMOND_E:
+        case TF_DIAMOND_B_BAR:
+        case TF_DIAMOND_E_BAR:
+        case TF_DIAMOND_D:
+        case TF_DIAMOND_D_BAR:
+        case TF_BOX_B:
+        case TF_BOX_E:
+        case TF_BOX_B_BAR:
+        case TF_BOX_E_BAR:
+        case TF_BOX_D:
+        case TF_BOX_D_BAR:
+            break;
+        default:
+            std::cerr << "Code Found:" << node.type << std::endl;
+            std::cerr << "Code Example: " << TF_BOX_E << std::endl;
+            throw std::string("Error: Illegal subformula or unimplemented type during abstract satisfiability checking");
+        }
+    }
 
-ThreeValueBool AbstractSatisfiabilityChecker::recurse(int subformula, int from, int to) {
+    std::vector<int> done(nodes.size(),0);
+    lengthDependent.resize(nodes.size(),false);
+    for (unsigned int i=0;i<nodes.size();i++) {
+        computeLengthDependence(i,done);
+    }
 
-    // Literal?
-    if (subformula<0) return ThreeValueBool::X;
+    std::vector<bool> visited(nodes.size(),false);
+    for (unsigned int i=0;i<nodes.size();i++) {
+        computeTopologicalOrder(i,visited);
+    }
 
-    //std::cerr << "Running: " << subformula << " as " << formulaFactory.getFormulas().at(subformula).get<0>() << "," << from << "," << to << std::endl;
-    // Caching
-    assert(from<=to);
-    assert(from>=0);
-    assert(to<wordLength);
-    auto itOldValue = doneList.find(boost::make_tuple(subformula,from,to));
-    if (itOldValue!=doneList.end()) return itOldValue->second;
+    values.resize(nodes.size());
+    reachable.resize(nodes.size());
+    rowOffsets.push_back(0);
+}
 
-    // Evaluate new sub-formula
-    FormulaType formulaType = formulaFactory.getFormulas().at(subformula).get<0>();
-    const std::set<int> &params = formulaFactory.getFormulas().at(subformula).get<1>();
-    ThreeValueBool result;
-    switch (formulaType) {
-    case TF_AND:
-        /* Special Case: Conjunction between the negation of an atomic proposition with itself
-         * -> Detect the encoding of "FALSE"
-         */
-        {
-            bool foundSpecialCase = false;
-            result = true; // Initialize here already so that the compiler does not complain
-            if (params.size()==2) {
-                bool foundPos = false;
-                bool foundNeg = false;
-                int apNumber = 0;
-                for (auto it = params.begin();it!=params.end();it++) {
-                    if (*it < 0) {
-                        if (apNumber!=0) {
-                            apNumber = *it;
-                            foundPos = true;
-                        } else if (*it == apNumber) {
-                            foundPos = true;
-                        }
-                    } else {
-                        if (formulaFactory.getFormulas()[*it].get<0>()==TF_NOT) {
-                            int negatedLiteral = formulaFactory.getSingleParameterOfTemporalSubformula(*it);
-                            if (apNumber==0) {
-                                apNumber = negatedLiteral;
-                                foundNeg = true;
-                            } else {
-                                if (negatedLiteral==apNumber) {
-                                    foundNeg = true;
-                                }
-                            }
-                        }
+/**
+ * @brief Determines whether the value of a subformula can depend on the word length.
+ * @param done stores for every subformula whether it has already been analysed
+ */
+bool AbstractSatisfiabilityChecker::computeLengthDependence(int subformula, std::vector<int> &done) {
+    if (subformula<0) return false;
+    if (done[subformula]) return lengthDependent[subformula];
+    done[subformula] = true;
 
+    FormulaType formulaType = nodes[subformula].type;
+    bool result = (formulaType==TF_DIAMOND_B_BAR) || (formulaType==TF_BOX_B_BAR) || (formulaType==TF_DIAMOND_A) || (formulaType==TF_BOX_A)
+            || (formulaType==TF_DIAMOND_D_BAR) || (formulaType==TF_BOX_D_BAR) || (formulaType==TF_DIAMOND_L) || (formulaType==TF_BOX_L)
+            || (formulaType==TF_DIAMOND_O) || (formulaType==TF_BOX_O);
+    const std::vector<int> &params = nodes[subformula].children;
+    for (auto it = params.begin();it!=params.end();it++) {
+        if (computeLengthDependence(*it,done)) result = true;
+    }
+    lengthDependent[subformula] = result;
+    return result;
+}
+
+/**
+ * @brief Appends the subformula to the topological order after everything that its value depends on.
+ */
+void AbstractSatisfiabilityChecker::computeTopologicalOrder(int subformula, std::vector<bool> &done) {
+    if ((subformula<0) || done[subformula]) return;
+    done[subformula] = true;
+    const std::vector<int> &params = nodes[subformula].children;
+    for (auto it = params.begin();it!=params.end();it++) {
+        computeTopologicalOrder(*it,done);
+    }
+    if (nodes[subformula].partner>=0) computeTopologicalOrder(nodes[subformula].partner,done);
+    topologicalOrder.push_back(subformula);
+}
+
+/**
+ * @brief Mask for the lanes of the given word that belong to a row with "nofLanes" lanes
+ */
+AbstractSatisfiabilityChecker::LaneWord AbstractSatisfiabilityChecker::getLaneMask(int nofLanes, int word) {
+    int lanesInWord = nofLanes-word*LANES_PER_WORD;
+    if (lanesInWord>=LANES_PER_WORD) return ~((LaneWord)0);
+    if (lanesInWord<=0) return 0;
+    return (((LaneWord)1) << (2*lanesInWord))-1;
+}
+
+/**
+ * @brief Word of a row of a child subformula - atomic propositions and their negations can have any value.
+ */
+AbstractSatisfiabilityChecker::LaneWord AbstractSatisfiabilityChecker::getChildWord(int child, int row, int word) const {
+    if (child<0) return replicate(ThreeValueBool::X) & getLaneMask(row+1,word);
+    return values[child][rowOffsets[row]+word];
+}
+
+/**
+ * @brief Updates the results for a new word length. Results for subformulas whose values cannot depend on the word length are kept
+ *        and only computed for the new intervals. All other values are recomputed.
+ * @param newWordLength the new word length, which must not be smaller than the previous one
+ */
+void AbstractSatisfiabilityChecker::extendWordLength(int newWordLength) {
+    assert(newWordLength>=wordLength);
+    int oldWordLength = wordLength;
+    wordLength = newWordLength;
+    for (int j=oldWordLength;j<wordLength;j++) {
+        rowOffsets.push_back(rowOffsets[j]+getNofWords(j+1));
+    }
+    for (auto it = topologicalOrder.begin();it!=topologicalOrder.end();it++) {
+        values[*it].resize(rowOffsets[wordLength],0);
+        computeValues(*it,lengthDependent[*it]?0:oldWordLength);
+    }
+    computeReachability();
+}
+
+/**
+ * @brief Computes the rows "firstRow" to "wordLength-1" of the table of a subformula. All subformulas that the
+ *        subformula depends on must have been computed before.
+ */
+void AbstractSatisfiabilityChecker::computeValues(int subformula, int firstRow) {
+    const Node &node = nodes[subformula];
+    std::vector<LaneWord> &self = values[subformula];
+    const int n = wordLength;
+    const bool isBox = node.type>=FIRST_BOX_FORMULA_TYPE;
+    const ThreeValueBool neutral = isBox?ThreeValueBool::TRUE:ThreeValueBool::FALSE;
+    LaneWord (*combine)(LaneWord, LaneWord) = isBox?combineAnd:combineOr;
+
+    switch (node.type) {
+    case TF_AND:
+    case TF_OR:
+        for (int j=firstRow;j<n;j++) {
+            for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                LaneWord mask = getLaneMask(j+1,w);
+                LaneWord result;
+                if (node.isContradiction) {
+                    result = replicate(ThreeValueBool::FALSE);
+                } else if (node.isTautology) {
+                    result = replicate(ThreeValueBool::TRUE);
+                } else if (node.type==TF_AND) {
+                    result = replicate(ThreeValueBool::TRUE);
+                    for (auto it = node.children.begin();it!=node.children.end();it++) {
+                        result = combineAnd(result,getChildWord(*it,j,w));
+                    }
+                } else {
+                    result = replicate(ThreeValueBool::FALSE);
+                    for (auto it = node.children.begin();it!=node.children.end();it++) {
+                        result = combineOr(result,getChildWord(*it,j,w));
                     }
                 }
-                if (foundPos && foundNeg) {
-                    foundSpecialCase = true;
-                    result = ThreeValueBool::FALSE;
-                }
-            }
-            if (!foundSpecialCase) {
-                for (auto it2 = params.begin();it2!=params.end();it2++) {
-                    result &= recurse(*it2,from,to);
-                }
+                self[rowOffsets[j]+w] = result & mask;
             }
         }
         break;
-    case TF_OR:
-        result = ThreeValueBool::FALSE;
-        for (auto it2 = params.begin();it2!=params.end();it2++) {
-            result |= recurse(*it2,from,to);
-        }
-        break;
     case TF_NOT:
-        {
-            int negatedLiteral = formulaFactory.getSingleParameterOfTemporalSubformula(subformula);
-            if (negatedLiteral>0) {
-                throw std::string("TF_NOT may only be applied to atomic propositions!");
-            } else {
-                result = ThreeValueBool::X;
+        for (int j=firstRow;j<n;j++) {
+            for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                self[rowOffsets[j]+w] = replicate(ThreeValueBool::X) & getLaneMask(j+1,w);
             }
         }
         break;
     case TF_DIAMOND_A:
+    case TF_BOX_A:
+        // The value only depends on the end point of the interval
+        for (int j=firstRow;j<n;j++) {
+            LaneWord value = replicate(ThreeValueBool(getLane(values[node.partner],j,j)));
+            for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                self[rowOffsets[j]+w] = value & getLaneMask(j+1,w);
+            }
+        }
+        break;
+    case TF_DIAMOND_A_BAR:
+    case TF_BOX_A_BAR:
         {
-            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_DIAMOND_B_BAR,params));
-            assert(it2!=formulaFactory.getFormulaNrs().end());
-            int relevantBBarSubformula = it2->second;
-            result = recurse(relevantBBarSubformula,to,to);
+            // The value only depends on the start point of the interval, so every row is a prefix of the diagonal of the partner
+            std::vector<LaneWord> diagonal(getNofWords(n),0);
+            for (int i=0;i<n;i++) {
+                diagonal[i/LANES_PER_WORD] |= ((LaneWord)getLane(values[node.partner],i,i)) << (2*(i%LANES_PER_WORD));
+            }
+            for (int j=firstRow;j<n;j++) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    self[rowOffsets[j]+w] = diagonal[w] & getLaneMask(j+1,w);
+                }
+            }
         }
         break;
     case TF_DIAMOND_B:
-        result = ThreeValueBool::FALSE;
-        for (int k=to-1;k>=from;k--) {
-            result |= recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),from,k);
+    case TF_BOX_B:
+        // (i,j) is the combination of (i,j-1) and the child on (i,j-1)
+        for (int j=firstRow;j<n;j++) {
+            if (j>0) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    LaneWord previousSelf = (w<rowOffsets[j]-rowOffsets[j-1])?self[rowOffsets[j-1]+w]:0;
+                    LaneWord previousChild = (w<rowOffsets[j]-rowOffsets[j-1])?getChildWord(node.child,j-1,w):0;
+                    self[rowOffsets[j]+w] = combine(previousSelf,previousChild);
+                }
+            }
+            setLane(self,j,j,neutral.getInternalValue());
         }
         break;
     case TF_DIAMOND_E:
-        result = ThreeValueBool::FALSE;
-        for (int k=from+1;k<=to;k++) {
-            result |= recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),k,to);
-        }
-        break;
-    case TF_DIAMOND_A_BAR:
-        result = ThreeValueBool::FALSE;
-        for (int k=0;k<from;k++) {
-            int intermediate = formulaFactory.getSingleParameterOfTemporalSubformula(subformula);
-            result |= recurse(intermediate,k,from);
+    case TF_BOX_E:
+        // (i,j) is the combination of (i+1,j) and the child on (i+1,j)
+        for (int j=firstRow;j<n;j++) {
+            LaneWord current = replicate(neutral) & 3;
+            setLane(self,j,j,(int)current);
+            for (int i=j-1;i>=0;i--) {
+                LaneWord childValue = (node.child<0)?3:getLane(values[node.child],i+1,j);
+                current = combine(current,childValue) & 3;
+                setLane(self,i,j,(int)current);
+            }
         }
         break;
     case TF_DIAMOND_E_BAR:
-        result = ThreeValueBool::FALSE;
-        for (int k=from-1;k>=0;k--) {
-            result |= recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),k,to);
+    case TF_BOX_E_BAR:
+        // (i,j) is the combination of (i-1,j) and the child on (i-1,j)
+        for (int j=firstRow;j<n;j++) {
+            LaneWord current = replicate(neutral) & 3;
+            setLane(self,0,j,(int)current);
+            for (int i=1;i<=j;i++) {
+                LaneWord childValue = (node.child<0)?3:getLane(values[node.child],i-1,j);
+                current = combine(current,childValue) & 3;
+                setLane(self,i,j,(int)current);
+            }
         }
         break;
     case TF_DIAMOND_B_BAR:
-        if (to>=(wordLength-1)) {
-            result = ThreeValueBool::FALSE;
-        } else {
-            result = recurse(subformula,from,to+1) | recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),from,to+1);
+    case TF_BOX_B_BAR:
+        // (i,j) is the combination of (i,j+1) and the child on (i,j+1). Intervals that end at the end of the word have no
+        // extensions.
+        assert(firstRow==0);
+        for (int j=n-1;j>=0;j--) {
+            for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                if (j==n-1) {
+                    self[rowOffsets[j]+w] = replicate(neutral) & getLaneMask(j+1,w);
+                } else {
+                    LaneWord nextSelf = self[rowOffsets[j+1]+w];
+                    LaneWord nextChild = getChildWord(node.child,j+1,w);
+                    self[rowOffsets[j]+w] = combine(nextSelf,nextChild) & getLaneMask(j+1,w);
+                }
+            }
         }
         break;
-    case TF_BOX_A:
-        {
-            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_BOX_B_BAR,params));
-            assert(it2!=formulaFactory.getFormulaNrs().end());
-            int relevantBBarSubformula = it2->second;
-            result = recurse(relevantBBarSubformula,to,to);
+    case TF_DIAMOND_D:
+    case TF_BOX_D:
+        // (i,j) is the combination of the child on (i+1,j-1) and of (i+1,j) and (i,j-1)
+        for (int j=firstRow;j<n;j++) {
+            for (int i=j;i>=0;i--) {
+                LaneWord current = replicate(neutral) & 3;
+                if (i+1<=j-1) current = combine(current,(node.child<0)?3:getLane(values[node.child],i+1,j-1)) & 3;
+                if (i<j) {
+                    current = combine(current,getLane(self,i+1,j)) & 3;
+                    current = combine(current,getLane(self,i,j-1)) & 3;
+                }
+                setLane(self,i,j,(int)current);
+            }
         }
         break;
-    case TF_BOX_B:
-        result = recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),from,to);
-        if (to==from) {
-            result = ThreeValueBool::TRUE;
-        } else {
-            result &= recurse(subformula,from,to-1);
+    case TF_DIAMOND_D_BAR:
+    case TF_BOX_D_BAR:
+        // (i,j) is the combination of the child on (i-1,j+1) and of (i-1,j) and (i,j+1). Intervals that end at the end
+        // of the word have no extensions.
+        assert(firstRow==0);
+        for (int j=n-1;j>=0;j--) {
+            for (int i=0;i<=j;i++) {
+                LaneWord current = replicate(neutral) & 3;
+                if (j+1<n) {
+                    if (i>0) current = combine(current,(node.child<0)?3:getLane(values[node.child],i-1,j+1)) & 3;
+                    current = combine(current,getLane(self,i,j+1)) & 3;
+                }
+                if (i>0) current = combine(current,getLane(self,i-1,j)) & 3;
+                setLane(self,i,j,(int)current);
+            }
         }
         break;
-    case TF_BOX_E:
-        result = recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),from,to);
-        if (to==from) {
-            result = ThreeValueBool::TRUE;
-        } else {
-            result &= recurse(subformula,from+1,to);
+    case TF_DIAMOND_L:
+    case TF_BOX_L:
+        {
+            // The value only depends on the end point j of the interval: it is the combination of the partner on all
+            // (k,k) with j<k<n
+            assert(firstRow==0);
+            LaneWord current = replicate(neutral);
+            for (int j=n-1;j>=0;j--) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    self[rowOffsets[j]+w] = current & getLaneMask(j+1,w);
+                }
+                current = combine(current,replicate(ThreeValueBool(getLane(values[node.partner],j,j))));
+            }
         }
         break;
-    case TF_BOX_A_BAR:
-        result = ThreeValueBool::TRUE;
-        for (int k=0;k<from;k++) {
-            result &= recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),k,from);
+    case TF_DIAMOND_L_BAR:
+    case TF_BOX_L_BAR:
+        {
+            // The value only depends on the start point i of the interval: it is the combination of the partner on all
+            // (k,k) with k<i, so every row is a prefix of the same diagonal
+            std::vector<LaneWord> diagonal(getNofWords(n),0);
+            LaneWord current = replicate(neutral) & 3;
+            for (int i=0;i<n;i++) {
+                diagonal[i/LANES_PER_WORD] |= current << (2*(i%LANES_PER_WORD));
+                current = combine(current,getLane(values[node.partner],i,i)) & 3;
+            }
+            for (int j=firstRow;j<n;j++) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    self[rowOffsets[j]+w] = diagonal[w] & getLaneMask(j+1,w);
+                }
+            }
         }
         break;
-    case TF_BOX_B_BAR:
-        result = ThreeValueBool::TRUE;
-        if (to>=(wordLength-1)) {
-            result = ThreeValueBool::TRUE;
-        } else {
-            result = recurse(subformula,from,to+1) & recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),from,to+1);
+    case TF_DIAMOND_O:
+    case TF_BOX_O:
+        // (i,j) is the combination of (i+1,j) and the partner on (i+1,j)
+        assert(firstRow==0);
+        for (int j=0;j<n;j++) {
+            LaneWord current = replicate(neutral) & 3;
+            setLane(self,j,j,(int)current);
+            for (int i=j-1;i>=0;i--) {
+                current = combine(current,getLane(values[node.partner],i+1,j)) & 3;
+                setLane(self,i,j,(int)current);
+            }
         }
         break;
-    case TF_BOX_E_BAR:
-        result = ThreeValueBool::TRUE;
-        for (int k=from-1;k>=0;k--) {
-            result &= recurse(formulaFactory.getSingleParameterOfTemporalSubformula(subformula),k,to);
+    case TF_DIAMOND_O_BAR:
+    case TF_BOX_O_BAR:
+        // (i,j) is the combination of (i,j-1) and the partner on (i,j-1)
+        for (int j=firstRow;j<n;j++) {
+            if (j>0) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    LaneWord previousSelf = (w<rowOffsets[j]-rowOffsets[j-1])?self[rowOffsets[j-1]+w]:0;
+                    LaneWord previousPartner = (w<rowOffsets[j]-rowOffsets[j-1])?values[node.partner][rowOffsets[j-1]+w]:0;
+                    self[rowOffsets[j]+w] = combine(previousSelf,previousPartner);
+                }
+            }
+            setLane(self,j,j,neutral.getInternalValue());
         }
         break;
     default:
-        std::cerr << "Code Found:" << formulaType << std::endl;
-        std::cerr << "Code Example: " << TF_BOX_E << std::endl;
         throw std::string("Error: Illegal subformula or unimplemented type during abstract satisfiability checking");
     }
+}
 
-    // Store result
-    assert(result!=ThreeValueBool::UNINITIALISED);
-    doneList[boost::make_tuple(subformula,from,to)] = result;
-    return result;
+/**
+ * @brief Computes which intervals of which subformulas are reachable from the main formula on (0,0). An interval of a
+ *        subformula is reachable if its SAT variable is referenced by the encoding of another reachable interval.
+ *        The subformulas are processed in reverse topological order, so that all references to a subformula are known
+ *        when it is processed.
+ */
+void AbstractSatisfiabilityChecker::computeReachability() {
+    const int n = wordLength;
+    for (unsigned int i=0;i<nodes.size();i++) {
+        reachable[i].assign(rowOffsets[n],0);
+    }
+    if ((mainFormula<0) || (n==0)) return;
+    setLane(reachable[mainFormula],0,0,1);
+
+    for (auto it = topologicalOrder.rbegin();it!=topologicalOrder.rend();it++) {
+        const Node &node = nodes[*it];
+        std::vector<LaneWord> &self = reachable[*it];
+        switch (node.type) {
+        case TF_AND:
+        case TF_OR:
+            for (auto it2 = node.children.begin();it2!=node.children.end();it2++) {
+                if (*it2>=0) {
+                    std::vector<LaneWord> &child = reachable[*it2];
+                    for (int w=0;w<rowOffsets[n];w++) child[w] |= self[w];
+                }
+            }
+            break;
+        case TF_NOT:
+            break;
+        case TF_DIAMOND_A:
+        case TF_BOX_A:
+            for (int j=0;j<n;j++) {
+                bool any = false;
+                for (int w=rowOffsets[j];w<rowOffsets[j+1];w++) any |= self[w]!=0;
+                if (any) setLane(reachable[node.partner],j,j,1);
+            }
+            break;
+        case TF_DIAMOND_A_BAR:
+        case TF_BOX_A_BAR:
+            {
+                std::vector<LaneWord> startPoints(getNofWords(n),0);
+                for (int j=0;j<n;j++) {
+                    for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) startPoints[w] |= self[rowOffsets[j]+w];
+                }
+                for (int i=0;i<n;i++) {
+                    if ((startPoints[i/LANES_PER_WORD] >> (2*(i%LANES_PER_WORD))) & 1) setLane(reachable[node.partner],i,i,1);
+                }
+            }
+            break;
+        case TF_DIAMOND_B:
+        case TF_BOX_B:
+            // (i,j) references (i,j-1) for i<j
+            for (int j=n-1;j>0;j--) {
+                for (int w=0;w<rowOffsets[j]-rowOffsets[j-1];w++) {
+                    LaneWord references = self[rowOffsets[j]+w] & getLaneMask(j,w);
+                    self[rowOffsets[j-1]+w] |= references;
+                    if (node.child>=0) reachable[node.child][rowOffsets[j-1]+w] |= references;
+                }
+            }
+            break;
+        case TF_DIAMOND_E:
+        case TF_BOX_E:
+            // (i,j) references (i+1,j) for i<j
+            for (int j=0;j<n;j++) {
+                for (int i=0;i<j;i++) {
+                    if (getLane(self,i,j)) {
+                        setLane(self,i+1,j,1);
+                        if (node.child>=0) setLane(reachable[node.child],i+1,j,1);
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_E_BAR:
+        case TF_BOX_E_BAR:
+            // (i,j) references (i-1,j) for i>0
+            for (int j=0;j<n;j++) {
+                for (int i=j;i>0;i--) {
+                    if (getLane(self,i,j)) {
+                        setLane(self,i-1,j,1);
+                        if (node.child>=0) setLane(reachable[node.child],i-1,j,1);
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_B_BAR:
+        case TF_BOX_B_BAR:
+            // (i,j) references (i,j+1) - The references to intervals touching the end of the word are not tracked here.
+            for (int j=0;j<n-1;j++) {
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    LaneWord references = self[rowOffsets[j]+w];
+                    self[rowOffsets[j+1]+w] |= references;
+                    if (node.child>=0) reachable[node.child][rowOffsets[j+1]+w] |= references;
+                }
+            }
+            break;
+        case TF_DIAMOND_D:
+        case TF_BOX_D:
+            // (i,j) references the child on (i+1,j-1) as well as (i+1,j) and (i,j-1) for i<j
+            for (int j=n-1;j>0;j--) {
+                for (int i=0;i<j;i++) {
+                    if (getLane(self,i,j)) {
+                        if ((i+1<=j-1) && (node.child>=0)) setLane(reachable[node.child],i+1,j-1,1);
+                        setLane(self,i+1,j,1);
+                        setLane(self,i,j-1,1);
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_D_BAR:
+        case TF_BOX_D_BAR:
+            // (i,j) references (i-1,j) for i>0 as well as the child on (i-1,j+1) and (i,j+1). The references to
+            // intervals touching the end of the word are not tracked here.
+            for (int j=0;j<n;j++) {
+                for (int i=j;i>=0;i--) {
+                    if (getLane(self,i,j)) {
+                        if (i>0) setLane(self,i-1,j,1);
+                        if (j+1<n) {
+                            if ((i>0) && (node.child>=0)) setLane(reachable[node.child],i-1,j+1,1);
+                            setLane(self,i,j+1,1);
+                        }
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_L:
+        case TF_BOX_L:
+            // (i,j) references (i,j+1) and the partner on (j+1,j+1)
+            for (int j=0;j<n-1;j++) {
+                bool any = false;
+                for (int w=0;w<rowOffsets[j+1]-rowOffsets[j];w++) {
+                    LaneWord references = self[rowOffsets[j]+w];
+                    self[rowOffsets[j+1]+w] |= references;
+                    any |= references!=0;
+                }
+                if (any) setLane(reachable[node.partner],j+1,j+1,1);
+            }
+            break;
+        case TF_DIAMOND_L_BAR:
+        case TF_BOX_L_BAR:
+            // (i,j) references (i-1,j) and the partner on (i-1,i-1) for i>0
+            for (int j=0;j<n;j++) {
+                for (int i=j;i>0;i--) {
+                    if (getLane(self,i,j)) {
+                        setLane(self,i-1,j,1);
+                        setLane(reachable[node.partner],i-1,i-1,1);
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_O:
+        case TF_BOX_O:
+            // (i,j) references (i+1,j) and the partner on (i+1,j) for i<j
+            for (int j=0;j<n;j++) {
+                for (int i=0;i<j;i++) {
+                    if (getLane(self,i,j)) {
+                        setLane(self,i+1,j,1);
+                        setLane(reachable[node.partner],i+1,j,1);
+                    }
+                }
+            }
+            break;
+        case TF_DIAMOND_O_BAR:
+        case TF_BOX_O_BAR:
+            // (i,j) references (i,j-1) and the partner on (i,j-1) for i<j
+            for (int j=n-1;j>0;j--) {
+                for (int w=0;w<rowOffsets[j]-rowOffsets[j-1];w++) {
+                    LaneWord references = self[rowOffsets[j]+w] & getLaneMask(j,w);
+                    self[rowOffsets[j-1]+w] |= references;
+                    reachable[node.partner][rowOffsets[j-1]+w] |= references;
+                }
+            }
+            break;
+        default:
+            throw std::string("Error: Illegal subformula or unimplemented type during abstract satisfiability checking");
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of bytes used by the value and reachability tables
+ */
+size_t AbstractSatisfiabilityChecker::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (unsigned int i=0;i<values.size();i++) bytes += values[i].capacity()*sizeof(LaneWord);
+    for (unsigned int i=0;i<reachable.size();i++) bytes += reachable[i].capacity()*sizeof(LaneWord);
+    return bytes;
 }
@@ -1,35 +1,34 @@
 #ifndef __ABSTRACT_SATISFIABILITY_CHECKER_HPP__
 #define __ABSTRACT_SATISFIABILITY_CHECKER_HPP__
 
-#include <map>
-#include <boost/tuple/tuple.hpp>
-#include <boost/tuple/tuple_comparison.hpp>
+#include <vector>
+#include <stdint.h>
+#include "formulaFactory.hpp"
 
 
 /**
-  * Three-Valued abstraction class
+  * Three-Valued abstraction class. The value is stored in "dual-rail" form: the lower bit states whether the
+  * value can be TRUE, and the upper bit states whether the value can be FALSE. The abstract satisfiability
+  * checker packs 32 such values into a 64-bit word and combines them with the same bit operations.
   */
 class ThreeValueBool {
 private:
     int value;
-    static const int threeValueBoolCombinationTableAND[];
-    static const int threeValueBoolCombinationTableOR[];
-    static const int threeValueBoolCombinationTableNOT[];
 public:
     ThreeValueBool(int _internalValue) : value(_internalValue) {}
     ThreeValueBool() : value(0) {} // Uninitialised
     ThreeValueBool operator&(const ThreeValueBool &other) const {
-        return ThreeValueBool(threeValueBoolCombinationTableAND[value*4+other.value]);
+        return ThreeValueBool(((value & other.value) & 1) | ((value | other.value) & 2));
     }
     ThreeValueBool operator|(const ThreeValueBool &other) const {
-        return ThreeValueBool(threeValueBoolCombinationTableOR[value*4+other.value]);
+        return ThreeValueBool(((value | other.value) & 1) | ((value & other.value) & 2));
     }
     ThreeValueBool& operator|=(const ThreeValueBool &other) {
-        value = threeValueBoolCombinationTableOR[value*4+other.value];
+        *this = *this | other;
         return *this;
     }
     ThreeValueBool operator&=(const ThreeValueBool &other) {
-        value = threeValueBoolCombinationTableAND[value*4+other.value];
+        *this = *this & other;
         return *this;
     }
     ThreeValueBool& operator=(const ThreeValueBool &other) {
@@ -37,7 +36,7 @@ public:
         return *this;
     }
     ThreeValueBool operator!() const {
-        return threeValueBoolCombinationTableNOT[value];
+        return ThreeValueBool(((value & 1) << 1) | ((value & 2) >> 1));
     }
     bool operator==(const ThreeValueBool &other) const {
         return value==other.value;
@@ -45,6 +44,7 @@ public:
     bool operator!=(const ThreeValueBool &other) const {
         return value!=other.value;
     }
+    int getInternalValue() const { return value; }
 
     // Constant Values
     static ThreeValueBool FALSE;
@@ -61,53 +61,104 @@ public:
  * form, we test if even replacing all atomic propositions and their negation by TRUE makes
  * a subformula satisfiabile on some interval and if it is reachable. In all other cases, we
  * can just set the corresponding atomic proposition in the SAT encoding to FALSE.
+ *
+ * The results are computed bottom-up: for every subformula, a triangular table with one
+ * value for every interval is filled row by row, where row j contains the intervals (i,j).
+ * All operators are evaluated with running aggregates, so that every table entry is computed
+ * in constant time, and most operators process a whole row of 32 intervals per machine word.
+ * Reachability of the intervals from the main formula on (0,0) is computed top-down in the same
+ * way, following the references between intervals made by the SAT encoding.
  */
 class AbstractSatisfiabilityChecker {
-    std::map<boost::tuple<int,int,int>,ThreeValueBool> doneList;
-
-    ThreeValueBool recurse(int subformula, int from, int to);
-    int wordLength;
 public:
-    AbstractSatisfiabilityChecker(int mainFormula, int _wordLength) : wordLength(_wordLength) { recurse(mainFormula,0,0); }
-    const std::map<boost::tuple<int,int,int>,ThreeValueBool> &getStorage() const { return doneList; }
-
-    class NonXResultIterator {
-        std::map<boost::tuple<int,int,int>,ThreeValueBool> &reference;
-        std::map<boost::tuple<int,int,int>,ThreeValueBool>::const_iterator it;
-        bool readCurrent;
-    public:
-        void searchNext() {
-            readCurrent = false;
-            while ((it!=reference.end()) && (it->second!=ThreeValueBool::FALSE) && (it->second!=ThreeValueBool::TRUE)) it++;
-        }
-        NonXResultIterator(std::map<boost::tuple<int,int,int>,ThreeValueBool> &doneList) : reference(doneList), it(doneList.begin()){
-            searchNext();
-        }
-        bool hasNext() {
-            return it!=reference.end();
-        }
-        bool isTrue() {
-            return it->second==ThreeValueBool::TRUE;
-        }
-        bool isFalse() {
-            return it->second==ThreeValueBool::FALSE;
-        }
-        int getSubformula() {
-            return it->first.get<0>();
-        }
-        int getFrom() {
-            return it->first.get<1>();
-        }
-        int getTo() {
-            return it->first.get<2>();
-        }
-    };
-    NonXResultIterator getNonXResultIterator() { return NonXResultIterator(doneList); }
-
+    typedef uint64_t LaneWord;
+    static const int LANES_PER_WORD = 32;
 
+private:
+    struct Node {
+        FormulaType type;
+        std::vector<int> children;
+        int child; // Only parameter of unary operators
+        int partner; // <B'>/<E'>/[B']/[E'] subformula used for the A, L, and O operators
+        bool isContradiction; // AND containing an atomic proposition and its negation
+        bool isTautology; // OR containing an atomic proposition and its negation
+    };
+    std::vector<Node> nodes;
+    std::vector<int> topologicalOrder;
+
+    /**
+     * @brief Stores for every subformula whether its value on some interval can depend on the length of the word,
+     *        which is the case whenever the subformula looks into the future of the interval (via the A, B', D',
+     *        L, and O operators). All other results stay valid when the word length is increased.
+     */
+    std::vector<bool> lengthDependent;
+
+    // Per subformula: values and reachability of all intervals. The reachability
+    // is stored in the "can be TRUE" bit of each lane.
+    std::vector<std::vector<LaneWord> > values;
+    std::vector<std::vector<LaneWord> > reachable;
+    std::vector<int> rowOffsets; // Word index of the start of each row, plus one more entry for the end of the table
+
+    int mainFormula;
+    int wordLength;
 
+    bool computeLengthDependence(int subformula, std::vector<int> &done);
+    void computeTopologicalOrder(int subformula, std::vector<bool> &done);
+    void computeValues(int subformula, int firstRow);
+    void computeReachability();
+
+    static int getNofWords(int nofLanes) { return (nofLanes+LANES_PER_WORD-1)/LANES_PER_WORD; }
+    static LaneWord getLaneMask(int nofLanes, int word);
+    static LaneWord replicate(ThreeValueBool value) { return 0x5555555555555555ULL*value.getInternalValue(); }
+    static LaneWord combineAnd(LaneWord a, LaneWord b) { return ((a & b) & 0x5555555555555555ULL) | ((a | b) & 0xAAAAAAAAAAAAAAAAULL); }
+    static LaneWord combineOr(LaneWord a, LaneWord b) { return ((a | b) & 0x5555555555555555ULL) | ((a & b) & 0xAAAAAAAAAAAAAAAAULL); }
+    int getLane(const std::vector<LaneWord> &table, int from, int to) const {
+        return (table[rowOffsets[to]+from/LANES_PER_WORD] >> (2*(from%LANES_PER_WORD))) & 3;
+    }
+    void setLane(std::vector<LaneWord> &table, int from, int to, int value) const {
+        LaneWord &word = table[rowOffsets[to]+from/LANES_PER_WORD];
+        int shift = 2*(from%LANES_PER_WORD);
+        word = (word & ~(((LaneWord)3) << shift)) | (((LaneWord)value) << shift);
+    }
+    LaneWord getChildWord(int child, int row, int word) const;
 
+public:
+    AbstractSatisfiabilityChecker(const FormulaFactory &factory, int _mainFormula);
+    void extendWordLength(int newWordLength);
+    int getWordLength() const { return wordLength; }
+    size_t getMemoryUsage() const;
+    bool isLengthDependent(int subformula) const { return lengthDependent[subformula]; }
+    ThreeValueBool getValue(int subformula, int from, int to) const {
+        if (subformula<0) return ThreeValueBool::X;
+        return ThreeValueBool(getLane(values[subformula],from,to));
+    }
+    bool isReachable(int subformula, int from, int to) const {
+        if (subformula<0) return true;
+        return getLane(reachable[subformula],from,to)!=0;
+    }
 
+    /**
+     * @brief Calls "callback(subformula,from,to,value)" for every reachable interval on which a subformula has been found
+     *        to be definitely TRUE (value=true) or FALSE (value=false).
+     */
+    template<class Callback> void forEachReachableNonXResult(Callback callback) const {
+        for (unsigned int subformula=0;subformula<nodes.size();subformula++) {
+            const std::vector<LaneWord> &valueTable = values[subformula];
+            const std::vector<LaneWord> &reachTable = reachable[subformula];
+            for (int to=0;to<wordLength;to++) {
+                for (int word=rowOffsets[to];word<rowOffsets[to+1];word++) {
+                    LaneWord value = valueTable[word];
+                    LaneWord candidates = reachTable[word] & (value ^ (value >> 1)) & 0x5555555555555555ULL;
+                    while (candidates!=0) {
+                        int bit = __builtin_ctzll(candidates);
+                        candidates &= candidates-1;
+                        int from = (word-rowOffsets[to])*LANES_PER_WORD+bit/2;
+                        callback((int)subformula,from,to,((value >> bit) & 1)!=0);
+                    }
+                }
+            }
+        }
+    }
 };
 
 
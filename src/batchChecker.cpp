@@ -0,0 +1,124 @@
+#include "batchChecker.hpp"
+#include "threadPool.hpp"
+#include "itlsat.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <sys/stat.h>
+
+BatchChecker::BatchChecker(const std::string &dirOrList, int _maxBound, int _nofThreads, const std::string &_satSolverBackend, std::ostream &_out) : out(_out) {
+    if (_maxBound==-1) {
+        throw std::string("The batch mode needs a maximum bound.");
+    }
+    files = collectFiles(dirOrList);
+    maxBound = _maxBound;
+    nofThreads = _nofThreads;
+    satSolverBackend = _satSolverBackend;
+    useActivationLiterals = false;
+    useSymmetryBreaking = false;
+    simplifyFormulas = true;
+    nativeDerivedOperators = true;
+    validateModels = false;
+    nofSatisfiable = 0;
+    nofUnsatisfiable = 0;
+    nofUnknown = 0;
+    nofUnsatisfiableForAllLengths = 0;
+    nofErrors = 0;
+}
+
+/**
+ * @brief Returns all ".itl" files in a directory (sorted by name), or the file names listed in a file, one per line
+ */
+std::vector<std::string> BatchChecker::collectFiles(const std::string &dirOrList) {
+    std::vector<std::string> result;
+    struct stat fileInfo;
+    if (stat(dirOrList.c_str(),&fileInfo)!=0) {
+        throw std::string("Cannot access '")+dirOrList+"'.";
+    }
+    if (S_ISDIR(fileInfo.st_mode)) {
+        DIR *dir = opendir(dirOrList.c_str());
+        if (dir==NULL) throw std::string("Cannot read the directory '")+dirOrList+"'.";
+        struct dirent *entry;
+        while ((entry = readdir(dir))!=NULL) {
+            std::string name = entry->d_name;
+            if ((name.size()>4) && (name.substr(name.size()-4)==".itl")) {
+                result.push_back(dirOrList+"/"+name);
+            }
+        }
+        closedir(dir);
+        std::sort(result.begin(),result.end());
+    } else {
+        std::ifstream list(dirOrList.c_str());
+        std::string line;
+        while (std::getline(list,line)) {
+            if ((line.size()>0) && (line[line.size()-1]=='\r')) line = line.substr(0,line.size()-1);
+            if (line!="") result.push_back(line);
+        }
+    }
+    return result;
+}
+
+void BatchChecker::checkFile(const std::string &filename) {
+    auto startTime = std::chrono::steady_clock::now();
+    std::ostringstream line;
+    line << filename << "\t";
+    bool isSatisfiable = false;
+    bool isUnknown = false;
+    bool isUnsatisfiable = false;
+    bool isError = false;
+    try {
+        ITLSatContext context;
+        context.setSatSolverBackend(satSolverBackend);
+        context.setUseActivationLiterals(useActivationLiterals);
+        context.setUseSymmetryBreaking(useSymmetryBreaking);
+        context.setSimplifyFormula(simplifyFormulas);
+        context.setNativeDerivedOperators(nativeDerivedOperators);
+        context.setResourceLimits(resourceLimits);
+        context.setResultCacheDirectory(resultCacheDirectory);
+        context.parseFile(filename);
+        BoundSearchResult result = context.check(maxBound);
+        if (validateModels && (result.status==BoundSearchResult::SATISFIABLE) && !context.validateModel()) {
+            throw std::string("The model found does not satisfy the formula.");
+        }
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+        isSatisfiable = result.status==BoundSearchResult::SATISFIABLE;
+        isUnknown = result.status==BoundSearchResult::UNKNOWN;
+        isUnsatisfiable = result.status==BoundSearchResult::UNSATISFIABLE;
+        line << (isSatisfiable?"sat":(isUnknown?"unknown":(isUnsatisfiable?"unsat-all":"unsat"))) << "\t" << result.bound;
+        line << "\t" << std::fixed << std::setprecision(3) << time << "\t" << result.nofVariables << "\t" << result.nofClauses;
+    } catch (std::string error) {
+        line << "error\t" << error;
+        isError = true;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex);
+    out << line.str() << std::endl;
+    if (isError) {
+        nofErrors++;
+    } else if (isSatisfiable) {
+        nofSatisfiable++;
+    } else if (isUnknown) {
+        nofUnknown++;
+    } else {
+        nofUnsatisfiable++;
+        if (isUnsatisfiable) nofUnsatisfiableForAllLengths++;
+    }
+}
+
+void BatchChecker::run() {
+    out << "File\tResult\tBound\tTime\tVariables\tClauses" << std::endl;
+    {
+        WorkStealingThreadPool pool(nofThreads);
+        for (auto it = files.begin();it!=files.end();it++) {
+            std::string filename = *it;
+            pool.submit([this,filename]() { checkFile(filename); });
+        }
+        pool.waitUntilIdle();
+    }
+    std::cerr << "Checked " << files.size() << " files: " << nofSatisfiable << " satisfiable, " << nofUnsatisfiable << " without a model up to the maximum bound of " << maxBound << " (" << nofUnsatisfiableForAllLengths << " of them without a model of any length), ";
+    if (nofUnknown>0) std::cerr << nofUnknown << " unknown due to resource limits, ";
+    std::cerr << nofErrors << " errors\n";
+}
@@ -0,0 +1,67 @@
+#ifndef __BATCH_CHECKER_HPP__
+#define __BATCH_CHECKER_HPP__
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <iostream>
+#include "satChecker.hpp"
+
+/**
+ * @brief Checks many formulas within one process. Every file is a job on a work-stealing thread pool and has its own
+ *        formula factory and satisfiability checker. The result of a job is written as one tab-separated line as soon
+ *        as the job has finished, so the order of the lines depends on the running times of the jobs. The result is
+ *        "unsat-all" instead of "unsat" if the formula has been found to have no model of any length.
+ */
+class BatchChecker {
+private:
+    std::vector<std::string> files;
+    int maxBound;
+    int nofThreads;
+    std::string satSolverBackend;
+    bool useActivationLiterals;
+    bool useSymmetryBreaking;
+    bool simplifyFormulas;
+    bool nativeDerivedOperators;
+    bool validateModels;
+    ResourceLimits resourceLimits;
+    std::string resultCacheDirectory;
+
+    std::mutex outputMutex;
+    std::ostream &out;
+    int nofSatisfiable;
+    int nofUnsatisfiable;
+    int nofUnknown;
+    int nofUnsatisfiableForAllLengths;
+    int nofErrors;
+
+    void checkFile(const std::string &filename);
+
+public:
+    BatchChecker(const std::string &dirOrList, int maxBound, int nofThreads, const std::string &satSolverBackend, std::ostream &out = std::cout);
+    void setUseActivationLiterals(bool value) { useActivationLiterals = value; }
+    void setUseSymmetryBreaking(bool value) { useSymmetryBreaking = value; }
+    void setSimplifyFormulas(bool value) { simplifyFormulas = value; }
+    void setNativeDerivedOperators(bool value) { nativeDerivedOperators = value; }
+
+    /**
+     * @brief Sets whether the models found are checked with the "CertificateValidator". Models that do not satisfy
+     *        their formula are reported as errors.
+     */
+    void setValidateModels(bool value) { validateModels = value; }
+
+    /**
+     * @brief Sets the resource limits of every job. Files for which a limit is reached are reported as "unknown". The
+     *        timeout counts per file, but the memory limit applies to the whole process.
+     */
+    void setResourceLimits(const ResourceLimits &limits) { resourceLimits = limits; }
+
+    /**
+     * @brief Sets a directory in which the results of all files are cached across runs (by default, none is used)
+     */
+    void setResultCacheDirectory(const std::string &directory) { resultCacheDirectory = directory; }
+    void run();
+    static std::vector<std::string> collectFiles(const std::string &dirOrList);
+};
+
+#endif
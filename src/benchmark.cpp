@@ -0,0 +1,166 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include "formulaFactory.hpp"
+#include "parser.hpp"
+#include "satChecker.hpp"
+#include "batchChecker.hpp"
+
+/**
+ * @brief Times of the phases of one check of a formula, in seconds. The keys are the phase and the bound (-1 for the
+ *        phases before the first bound). The phases are kept in the order in which they first occurred.
+ */
+struct PhaseTimes {
+    std::vector<std::pair<std::string,int> > order;
+    std::map<std::pair<std::string,int>,double> times;
+    void add(const std::string &phase, int bound, double seconds) {
+        std::pair<std::string,int> key(phase,bound);
+        if (times.count(key)==0) order.push_back(key);
+        times[key] += seconds;
+    }
+};
+
+/**
+ * @brief Checks the formula in the same way as "itlsc" with the linear bound strategy and records the time of every phase
+ */
+static BoundSearchResult checkOnce(const std::string &text, int maxBound, bool simplifyFormula, bool nativeDerivedOperators, const std::string &satSolverBackend, PhaseTimes &times) {
+    auto totalStartTime = std::chrono::steady_clock::now();
+    PhaseTimingCallback callback = [&times](const char *phase, int bound, double seconds) { times.add(phase,bound,seconds); };
+
+    FormulaFactory factory;
+    auto startTime = std::chrono::steady_clock::now();
+    int formula = parseFormula(factory,text.data(),text.size());
+    times.add("parse",-1,std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count());
+    formula = SatisfiabilityChecker::prepareFormula(factory,formula,false,simplifyFormula,nativeDerivedOperators,callback);
+
+    SatisfiabilityChecker checker(factory,formula,satSolverBackend);
+    checker.setPhaseTimingCallback(callback);
+    BoundSearchResult result = checker.searchMinimalModel(maxBound);
+    times.add("total",-1,std::chrono::duration<double>(std::chrono::steady_clock::now()-totalStartTime).count());
+    return result;
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted samples
+ */
+static double percentile(const std::vector<double> &sortedSamples, double fraction) {
+    int rank = (int)std::ceil(fraction*sortedSamples.size());
+    return sortedSamples[std::min(std::max(rank,1),(int)sortedSamples.size())-1];
+}
+
+int main(int argv, const char **args) {
+    int maxBound = -1;
+    int nofWarmupRuns = 1;
+    int nofRepetitions = 5;
+    bool simplifyFormula = true;
+    bool nativeDerivedOperators = true;
+    std::string satSolverBackend = "picosat";
+    std::string files = "";
+    for (int i=1;i<argv;i++) {
+        std::string current = args[i];
+        if ((current=="--max-bound") || (current=="--warmup") || (current=="--repetitions")) {
+            int value = 0;
+            if (i<argv-1) {
+                std::istringstream is(args[i+1]);
+                is >> value;
+                if (is.fail()) value = -1;
+                i++;
+            } else {
+                value = -1;
+            }
+            if ((value<0) || ((value==0) && (current!="--warmup"))) {
+                std::cerr << "Error: No valid number given after " << current << "\n";
+                return 1;
+            }
+            if (current=="--max-bound") {
+                maxBound = value;
+            } else if (current=="--warmup") {
+                nofWarmupRuns = value;
+            } else {
+                nofRepetitions = value;
+            }
+        } else if (current=="--no-simplify") {
+            simplifyFormula = false;
+        } else if (current=="--derived-operators") {
+            if (i==argv-1) {
+                std::cerr << "Error: No encoding given after parameter --derived-operators\n";
+                return 1;
+            }
+            std::string encoding = args[++i];
+            if (encoding=="native") {
+                nativeDerivedOperators = true;
+            } else if (encoding=="desugar") {
+                nativeDerivedOperators = false;
+            } else {
+                std::cerr << "Error: Unknown encoding of the derived operators '" << encoding << "'. Supported are 'native' and 'desugar'.\n";
+                return 1;
+            }
+        } else if (current=="--sat-solver") {
+            if (i==argv-1) {
+                std::cerr << "Error: No solver given after parameter --sat-solver\n";
+                return 1;
+            }
+            satSolverBackend = args[++i];
+        } else if ((files=="") && (current.substr(0,2)!="--")) {
+            files = current;
+        } else {
+            std::cerr << "Error: Did not understand option '" << current << "'\n";
+            return 1;
+        }
+    }
+    if ((files=="") || (maxBound==-1)) {
+        std::cerr << "Usage: itlbench [--warmup <n>] [--repetitions <n>] [--no-simplify] [--derived-operators <encoding>] [--sat-solver <solver>] --max-bound <n> <directory or file list>\n";
+        return 1;
+    }
+
+    try {
+        std::cout << "File\tPhase\tBound\tMedian [ms]\tP10 [ms]\tP90 [ms]" << std::endl;
+        std::vector<std::string> filenames = BatchChecker::collectFiles(files);
+        for (auto it = filenames.begin();it!=filenames.end();it++) {
+            std::ifstream inFile(it->c_str());
+            if (inFile.fail()) throw std::string("Cannot read the file '")+*it+"'.";
+            std::ostringstream contents;
+            contents << inFile.rdbuf();
+            std::string text = contents.str();
+
+            // Warmup runs fill the caches and let the memory allocator reach a steady state, and are not counted
+            std::vector<PhaseTimes> runs;
+            std::vector<BoundSearchResult> results;
+            try {
+                for (int run=0;run<nofWarmupRuns+nofRepetitions;run++) {
+                    PhaseTimes times;
+                    results.push_back(checkOnce(text,maxBound,simplifyFormula,nativeDerivedOperators,satSolverBackend,times));
+                    const BoundSearchResult &result = results.back();
+                    if ((result.status!=results[0].status) || (result.bound!=results[0].bound) || (result.nofClauses!=results[0].nofClauses)) {
+                        throw std::string("The result differs between the runs.");
+                    }
+                    if (run>=nofWarmupRuns) runs.push_back(times);
+                }
+            } catch (std::string error) {
+                std::cout << *it << "\terror\t" << error << std::endl;
+                continue;
+            }
+
+            // All runs have had the same result, so they should have the same phases. Missing ones count as taking no time.
+            for (auto phase = runs[0].order.begin();phase!=runs[0].order.end();phase++) {
+                std::vector<double> samples;
+                for (auto run = runs.begin();run!=runs.end();run++) {
+                    auto finder = run->times.find(*phase);
+                    samples.push_back((finder==run->times.end())?0.0:finder->second*1000.0);
+                }
+                std::sort(samples.begin(),samples.end());
+                std::cout << *it << "\t" << phase->first << "\t";
+                if (phase->second!=-1) std::cout << phase->second;
+                std::cout << "\t" << std::fixed << std::setprecision(3) << percentile(samples,0.5) << "\t" << percentile(samples,0.1) << "\t" << percentile(samples,0.9) << std::endl;
+            }
+            std::cerr << *it << ": " << ((results[0].status==BoundSearchResult::SATISFIABLE)?"sat":((results[0].status==BoundSearchResult::UNSATISFIABLE)?"unsat-all":"unsat")) << " at bound " << results[0].bound << std::endl;
+        }
+    } catch (std::string error) {
+        std::cerr << "Error: " << error << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,6 @@
+TEMPLATE = app
+TARGET = itlbench
+CONFIG = console release
+
+include(itlsat.pri)
+SOURCES += benchmark.cpp
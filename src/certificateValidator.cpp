@@ -0,0 +1,282 @@
+#include "certificateValidator.hpp"
+#include <sstream>
+
+CertificateValidator::CertificateValidator(const FormulaFactory &_factory, int _wordLength, const Certificate &certificate) : factory(_factory), wordLength(_wordLength) {
+    if (wordLength<1) {
+        throw std::string("Certificates must be for words of length at least 1.");
+    }
+    nofWordsPerRow = (wordLength+63)/64;
+
+    // Atomic propositions
+    apValues.assign(factory.getAPNrs().size(),Table(wordLength*nofWordsPerRow,0));
+    for (auto it = certificate.begin();it!=certificate.end();it++) {
+        auto finder = factory.getAPNrs().find(it->first);
+        if (finder==factory.getAPNrs().end()) {
+            throw std::string("The certificate contains the unknown atomic proposition '")+it->first+"'.";
+        }
+        Table &table = apValues[-finder->second-1];
+        for (auto it2 = it->second.begin();it2!=it->second.end();it2++) {
+            int from = it2->first;
+            int to = it2->second;
+            if ((from<0) || (from>to) || (to>=wordLength)) {
+                std::ostringstream error;
+                error << "The certificate contains the interval (" << from << "," << to << ") for the atomic proposition '" << it->first << "', which is not within a word of length " << wordLength << ".";
+                throw error.str();
+            }
+            row(table,to)[from/64] |= 1ULL << (from%64);
+        }
+    }
+
+    // Subformulas. Children always have smaller numbers than their parents.
+    values.resize(factory.getNofFormulas());
+    for (unsigned int i=0;i<factory.getNofFormulas();i++) {
+        evaluate(i);
+    }
+}
+
+/**
+ * @brief Returns the bits of the given word of row "to" that belong to intervals, i.e., those for the start points 0 to "to"
+ */
+uint64_t CertificateValidator::rowMask(int to, unsigned int word) const {
+    int firstStart = word*64;
+    if (firstStart>to) return 0;
+    if (to-firstStart>=63) return ~0ULL;
+    return (1ULL << (to-firstStart+1))-1;
+}
+
+bool CertificateValidator::getBit(const Table &table, int from, int to) const {
+    return (row(table,to)[from/64] >> (from%64)) & 1;
+}
+
+void CertificateValidator::complement(const Table &source, Table &destination) const {
+    for (int j=0;j<wordLength;j++) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = ~row(source,j)[w] & rowMask(j,w);
+        }
+    }
+}
+
+/**
+ * @brief <B>: some proper prefix (i,j') with j'<j satisfies the parameter, so row j is row j-1 or-ed with the parameter on row j-1
+ */
+void CertificateValidator::diamondB(const Table &source, Table &destination) const {
+    for (unsigned int w=0;w<nofWordsPerRow;w++) row(destination,0)[w] = 0;
+    for (int j=1;j<wordLength;j++) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = row(destination,j-1)[w] | row(source,j-1)[w];
+        }
+    }
+}
+
+/**
+ * @brief <B'>: some proper extension (i,k) with j<k satisfies the parameter - the same as for <B>, but from the end of the word
+ */
+void CertificateValidator::diamondBBar(const Table &source, Table &destination) const {
+    for (unsigned int w=0;w<nofWordsPerRow;w++) row(destination,wordLength-1)[w] = 0;
+    for (int j=wordLength-2;j>=0;j--) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = (row(destination,j+1)[w] | row(source,j+1)[w]) & rowMask(j,w);
+        }
+    }
+}
+
+/**
+ * @brief <E>: some proper suffix (i',j) with i<i' satisfies the parameter, so bit i of row j is set if there is a
+ *        higher bit in the row of the parameter
+ */
+void CertificateValidator::diamondE(const Table &source, Table &destination) const {
+    for (int j=0;j<wordLength;j++) {
+        bool found = false;
+        for (int w=nofWordsPerRow-1;w>=0;w--) {
+            uint64_t bits = row(source,j)[w];
+            uint64_t result = found?~0ULL:0;
+            if (bits!=0) {
+                result |= (1ULL << (63-__builtin_clzll(bits)))-1;
+                found = true;
+            }
+            row(destination,j)[w] = result & rowMask(j,w);
+        }
+    }
+}
+
+/**
+ * @brief <E'>: some proper extension (m,j) with m<i satisfies the parameter, so bit i of row j is set if there is a
+ *        lower bit in the row of the parameter
+ */
+void CertificateValidator::diamondEBar(const Table &source, Table &destination) const {
+    for (int j=0;j<wordLength;j++) {
+        bool found = false;
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            uint64_t bits = row(source,j)[w];
+            uint64_t result = found?~0ULL:0;
+            if (bits!=0) {
+                uint64_t lowest = bits & (~bits+1);
+                result |= ~(lowest | (lowest-1));
+                found = true;
+            }
+            row(destination,j)[w] = result & rowMask(j,w);
+        }
+    }
+}
+
+/**
+ * @brief <A>: some interval (j,k) with k>j satisfies the parameter, which only depends on j and is <B'> on (j,j)
+ */
+void CertificateValidator::diamondA(const Table &source, Table &destination) const {
+    Table extensions(source.size());
+    diamondBBar(source,extensions);
+    for (int j=0;j<wordLength;j++) {
+        bool value = getBit(extensions,j,j);
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = value?rowMask(j,w):0;
+        }
+    }
+}
+
+/**
+ * @brief <A'>: some interval (m,i) with m<i satisfies the parameter, which only depends on i and is <E'> on (i,i)
+ */
+void CertificateValidator::diamondABar(const Table &source, Table &destination) const {
+    Table extensions(source.size());
+    diamondEBar(source,extensions);
+    std::vector<uint64_t> starts(nofWordsPerRow,0);
+    for (int i=0;i<wordLength;i++) {
+        if (getBit(extensions,i,i)) starts[i/64] |= 1ULL << (i%64);
+    }
+    for (int j=0;j<wordLength;j++) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = starts[w] & rowMask(j,w);
+        }
+    }
+}
+
+/**
+ * @brief <L>: some interval (k,m) with j<k<m satisfies the parameter, i.e., <B'> holds on some (k,k) with k>j
+ */
+void CertificateValidator::diamondL(const Table &source, Table &destination) const {
+    Table extensions(source.size());
+    diamondBBar(source,extensions);
+    bool value = false;
+    for (int j=wordLength-1;j>=0;j--) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = value?rowMask(j,w):0;
+        }
+        value = value || getBit(extensions,j,j);
+    }
+}
+
+/**
+ * @brief <L'>: some interval (m,k) with m<k<i satisfies the parameter, i.e., <E'> holds on some (k,k) with k<i
+ */
+void CertificateValidator::diamondLBar(const Table &source, Table &destination) const {
+    Table extensions(source.size());
+    diamondEBar(source,extensions);
+    std::vector<uint64_t> starts(nofWordsPerRow,0);
+    bool value = false;
+    for (int i=0;i<wordLength;i++) {
+        if (value) starts[i/64] |= 1ULL << (i%64);
+        value = value || getBit(extensions,i,i);
+    }
+    for (int j=0;j<wordLength;j++) {
+        for (unsigned int w=0;w<nofWordsPerRow;w++) {
+            row(destination,j)[w] = starts[w] & rowMask(j,w);
+        }
+    }
+}
+
+void CertificateValidator::diamond(FormulaType type, const Table &source, Table &destination) const {
+    Table intermediate(source.size());
+    switch (type) {
+    case TF_DIAMOND_A: diamondA(source,destination); break;
+    case TF_DIAMOND_B: diamondB(source,destination); break;
+    case TF_DIAMOND_E: diamondE(source,destination); break;
+    case TF_DIAMOND_A_BAR: diamondABar(source,destination); break;
+    case TF_DIAMOND_B_BAR: diamondBBar(source,destination); break;
+    case TF_DIAMOND_E_BAR: diamondEBar(source,destination); break;
+    case TF_DIAMOND_L: diamondL(source,destination); break;
+    case TF_DIAMOND_L_BAR: diamondLBar(source,destination); break;
+    case TF_DIAMOND_D:
+        // <D> = <E><B>
+        diamondB(source,intermediate);
+        diamondE(intermediate,destination);
+        break;
+    case TF_DIAMOND_D_BAR:
+        // <D'> = <E'><B'>
+        diamondBBar(source,intermediate);
+        diamondEBar(intermediate,destination);
+        break;
+    case TF_DIAMOND_O:
+        // <O> = <E><B'>
+        diamondBBar(source,intermediate);
+        diamondE(intermediate,destination);
+        break;
+    case TF_DIAMOND_O_BAR:
+        // <O'> = <B><E'>
+        diamondEBar(source,intermediate);
+        diamondB(intermediate,destination);
+        break;
+    default:
+        throw std::string("Internal error: Not a diamond operator in 'CertificateValidator::diamond'.");
+    }
+}
+
+void CertificateValidator::evaluate(int formula) {
+    FormulaType type = factory.getFormulaType(formula);
+    FormulaChildren children = factory.getChildren(formula);
+    Table &result = values[formula];
+    result.assign(wordLength*nofWordsPerRow,0);
+    switch (type) {
+    case TF_AND:
+        for (int j=0;j<wordLength;j++) {
+            for (unsigned int w=0;w<nofWordsPerRow;w++) row(result,j)[w] = rowMask(j,w);
+        }
+        for (auto it = children.begin();it!=children.end();it++) {
+            const Table &child = getValues(*it);
+            for (unsigned int k=0;k<result.size();k++) result[k] &= child[k];
+        }
+        break;
+    case TF_OR:
+        for (auto it = children.begin();it!=children.end();it++) {
+            const Table &child = getValues(*it);
+            for (unsigned int k=0;k<result.size();k++) result[k] |= child[k];
+        }
+        break;
+    case TF_NOT:
+        complement(getValues(children[0]),result);
+        break;
+    default:
+        if (type>=FIRST_BOX_FORMULA_TYPE) {
+            // [X] = not <X> not
+            FormulaType diamondType = (FormulaType)(type-FIRST_BOX_FORMULA_TYPE+TF_DIAMOND_A);
+            Table negated(result.size());
+            Table negatedResult(result.size());
+            complement(getValues(children[0]),negated);
+            diamond(diamondType,negated,negatedResult);
+            complement(negatedResult,result);
+        } else {
+            diamond(type,getValues(children[0]),result);
+        }
+    }
+}
+
+/**
+ * @brief Returns if the formula (or atomic proposition) holds on the interval (from,to)
+ */
+bool CertificateValidator::holds(int formula, int from, int to) const {
+    if ((from<0) || (from>to) || (to>=wordLength)) {
+        throw std::string("Cannot evaluate a formula on an interval that is not within the word.");
+    }
+    if ((formula<0)?(-formula-1>=(int)apValues.size()):(formula>=(int)values.size())) {
+        throw std::string("Cannot evaluate an unknown formula.");
+    }
+    return getBit(getValues(formula),from,to);
+}
+
+/**
+ * @brief Checks if the formula holds on the first point of a word of the given length, in which the atomic propositions
+ *        hold on the intervals given in the certificate (and nowhere else)
+ */
+bool CertificateValidator::validate(const FormulaFactory &factory, int formula, int wordLength, const Certificate &certificate) {
+    CertificateValidator validator(factory,wordLength,certificate);
+    return validator.holds(formula,0,0);
+}
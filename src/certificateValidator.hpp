@@ -0,0 +1,59 @@
+#ifndef __CERTIFICATE_VALIDATOR_HPP__
+#define __CERTIFICATE_VALIDATOR_HPP__
+
+#include <vector>
+#include <map>
+#include <string>
+#include <stdint.h>
+#include "formulaFactory.hpp"
+
+/**
+ * @brief Evaluates a formula on a word that is given by the intervals on which its atomic propositions hold (the format
+ *        of the satisfiability certificates), independently of the SAT encoding. Can be used for checking that a model
+ *        found by the SAT solver really satisfies the formula.
+ *
+ * The truth values of all subformulas on all intervals are computed by dynamic programming over the subformulas in the
+ * order of their numbers (children before parents). For every subformula, the values are stored as one bitset per
+ * interval end point j, in which bit i is set if the subformula holds on (i,j), so that the temporal operators can be
+ * evaluated one machine word of interval start points at a time. The derived operators L, D, and O are evaluated
+ * as the compositions of the basic operators that they stand for, and box operators as the duals of the diamonds.
+ * Intervals are strict in the same way as in the SAT encoding, so, e.g., <B> refers to the proper prefixes of an
+ * interval, and <A> to the intervals (j,k) with k>j.
+ */
+class CertificateValidator {
+private:
+    typedef std::vector<uint64_t> Table;
+
+    const FormulaFactory &factory;
+    int wordLength;
+    unsigned int nofWordsPerRow;
+    std::vector<Table> apValues;
+    std::vector<Table> values;
+
+    uint64_t *row(Table &table, int to) const { return table.data()+to*nofWordsPerRow; }
+    const uint64_t *row(const Table &table, int to) const { return table.data()+to*nofWordsPerRow; }
+    uint64_t rowMask(int to, unsigned int word) const;
+    bool getBit(const Table &table, int from, int to) const;
+    const Table &getValues(int formula) const { return (formula<0)?apValues[-formula-1]:values[formula]; }
+
+    // Evaluation of the operators. Every function writes to a table of the correct size
+    void complement(const Table &source, Table &destination) const;
+    void diamondA(const Table &source, Table &destination) const;
+    void diamondB(const Table &source, Table &destination) const;
+    void diamondE(const Table &source, Table &destination) const;
+    void diamondABar(const Table &source, Table &destination) const;
+    void diamondBBar(const Table &source, Table &destination) const;
+    void diamondEBar(const Table &source, Table &destination) const;
+    void diamondL(const Table &source, Table &destination) const;
+    void diamondLBar(const Table &source, Table &destination) const;
+    void diamond(FormulaType type, const Table &source, Table &destination) const;
+    void evaluate(int formula);
+
+public:
+    typedef std::map<std::string,std::vector<std::pair<int,int> > > Certificate;
+    CertificateValidator(const FormulaFactory &factory, int wordLength, const Certificate &certificate);
+    bool holds(int formula, int from, int to) const;
+    static bool validate(const FormulaFactory &factory, int formula, int wordLength, const Certificate &certificate);
+};
+
+#endif
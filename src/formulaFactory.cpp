@@ -1,6 +1,8 @@
 #include "formulaFactory.hpp"
 #include <cassert>
 #include <iostream>
+#include <limits>
+#include <boost/functional/hash.hpp>
 
 /**
  * @brief Debugging function for simple printing of subformula types
@@ -44,29 +46,30 @@ std::ostream& operator<<(std::ostream& lhs, FormulaType e) {
 }
 
 
-void FormulaFactory::printFormula(int nr, int level) {
+void FormulaFactory::printFormula(int nr, int level) const {
     assert(nr<(int)(formulas.size()));
     for (int i=0;i<level;i++) std::cout << " ";
     if (nr<0) {
         std::cout << aps[-nr-1] << std::endl;
     } else {
-        switch (formulas[nr].get<0>()) {
+        const FormulaNode &node = formulas[nr];
+        switch (node.type) {
             case TF_AND:
                 std::cout << "AND\n";
-                for (std::set<int>::iterator it = formulas[nr].get<1>().begin();it!=formulas[nr].get<1>().end();it++)
-                    printFormula(*it, level+2);
+                for (unsigned int i=0;i<node.nofChildren;i++)
+                    printFormula(node.children[i], level+2);
                 break;
         case TF_OR:
             std::cout << "OR\n";
-            for (std::set<int>::iterator it = formulas[nr].get<1>().begin();it!=formulas[nr].get<1>().end();it++)
-                printFormula(*it, level+2);
+            for (unsigned int i=0;i<node.nofChildren;i++)
+                printFormula(node.children[i], level+2);
             break;
         case TF_NOT:
             std::cout << "NOT\n";
-            assert(formulas[nr].get<1>().size()==1);
-            printFormula(*(formulas[nr].get<1>().begin()), level+2);
+            assert(node.nofChildren==1);
+            printFormula(node.children[0], level+2);
             break;
-#define COVER_TEMPORAL_CASE(a,txt) case a: std::cout << txt << std::endl; assert(formulas[nr].get<1>().size()==1); printFormula(*(formulas[nr].get<1>().begin()), level+2); break;
+#define COVER_TEMPORAL_CASE(a,txt) case a: std::cout << txt << std::endl; assert(node.nofChildren==1); printFormula(node.children[0], level+2); break;
         COVER_TEMPORAL_CASE(TF_DIAMOND_A,"<A>")
         COVER_TEMPORAL_CASE(TF_DIAMOND_B,"<B>")
         COVER_TEMPORAL_CASE(TF_DIAMOND_E,"<E>")
@@ -104,14 +107,12 @@ int FormulaFactory::makePositiveNormalForm(int startingFormula, bool negated) {
         if (!negated) {
             return startingFormula;
         } else {
-            std::set<int> res;
-            res.insert(startingFormula);
-            return insertSubformula(boost::make_tuple(TF_NOT,res));
+            return getNot(startingFormula);
         }
     }
 
     // Negation
-    if (formulas[startingFormula].get<0>() == TF_NOT) {
+    if (formulas[startingFormula].type == TF_NOT) {
         if (getSingleParameterOfTemporalSubformula(startingFormula)<0) {
             if (negated) {
 
@@ -125,17 +126,17 @@ int FormulaFactory::makePositiveNormalForm(int startingFormula, bool negated) {
     }
 
     // All other cases
-    std::set<int> res;
-    std::set<int> orig = formulas[startingFormula].get<1>();
+    std::vector<int> res;
+    FormulaChildren orig = getChildren(startingFormula);
     for (auto it = orig.begin();it!=orig.end();it++) {
         int thisResult = makePositiveNormalForm(*it,negated);
         assert(thisResult!=startingFormula);
-        res.insert(thisResult);
+        res.push_back(thisResult);
     }
 
     FormulaType newType;
     if (negated) {
-        switch (formulas[startingFormula].get<0>()) {
+        switch (formulas[startingFormula].type) {
         case TF_AND:
             newType = TF_OR; break;
         case TF_OR:
@@ -189,23 +190,23 @@ int FormulaFactory::makePositiveNormalForm(int startingFormula, bool negated) {
         case TF_BOX_O_BAR:
              newType = TF_DIAMOND_O_BAR; break;
         default:
-            std::cerr << "Offending type: " << formulas[startingFormula].get<0>() << std::endl;
+            std::cerr << "Offending type: " << formulas[startingFormula].type << std::endl;
             throw std::string("Did not find a formula type during translation into positive normal form.");
         }
     } else {
-        newType = formulas[startingFormula].get<0>();
+        newType = formulas[startingFormula].type;
     }
-    return insertSubformula(boost::make_tuple(newType,res));
+    return insertSubformula(newType,res);
 }
 
 void FormulaFactory::printFormulaTable() {
     std::cerr << "Formula Table: \n";
     for (uint i=0;i<formulas.size();i++) {
-        std::cerr << i << "\t" << formulas[i].get<0>() << "\t{";
-        for (auto it = formulas[i].get<1>().begin();it!=formulas[i].get<1>().end();it++) {
-            std::cerr << *it << " ";
+        std::cerr << i << "\t" << formulas[i].type << "\t{";
+        for (unsigned int j=0;j<formulas[i].nofChildren;j++) {
+            std::cerr << formulas[i].children[j] << " ";
         }
-        std::cerr << "}\t" << formulaNrs[formulas[i]];
+        std::cerr << "}\t" << findSubformula(formulas[i].type,getChildren(i));
         std::cerr << "\n";
     }
 
@@ -222,62 +223,50 @@ int FormulaFactory::encodeDerivedTemporalOperators(int startingFormula) {
     if (startingFormula<0) return startingFormula;
 
     // If not, then recurse
-    std::set<int> res;
-    std::set<int> from = formulas[startingFormula].get<1>();
+    std::vector<int> res;
+    FormulaChildren from = getChildren(startingFormula);
     for (auto it = from.begin();it!=from.end();it++) {
-        res.insert(encodeDerivedTemporalOperators(*it));
+        res.push_back(encodeDerivedTemporalOperators(*it));
     }
 
 
-    switch (formulas[startingFormula].get<0>()) {
+    switch (formulas[startingFormula].type) {
     case TF_DIAMOND_L:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_A,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_A,params));
+            int aSubFormula = insertSubformula(TF_DIAMOND_A,res);
+            return getTemporalFormula(TF_DIAMOND_A,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_BOX_L:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_A,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_A,params));
+            int aSubFormula = insertSubformula(TF_BOX_A,res);
+            return getTemporalFormula(TF_BOX_A,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_DIAMOND_O:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_B_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_E,params));
+            int aSubFormula = insertSubformula(TF_DIAMOND_B_BAR,res);
+            return getTemporalFormula(TF_DIAMOND_E,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_BOX_O:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_B_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_E,params));
+            int aSubFormula = insertSubformula(TF_BOX_B_BAR,res);
+            return getTemporalFormula(TF_BOX_E,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_DIAMOND_D:
     {
         // To things a bit smarter: as we have two possible encoding (<B><E> and <E><B>), check if we already have
         // one present and use that one then.
-        auto it = formulaNrs.find(boost::make_tuple(TF_DIAMOND_E,res));
-        if (it==formulaNrs.end()) {
+        int existing = findSubformula(TF_DIAMOND_E,res);
+        if (existing==NO_SUBFORMULA) {
             // Let's do <E><B> then
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_B,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_E,params));
+            int aSubFormula = insertSubformula(TF_DIAMOND_B,res);
+            return getTemporalFormula(TF_DIAMOND_E,aSubFormula);
         } else {
             // Let's do <B><E> -- the latter is already present
-            std::set<int> params;
-            params.insert(it->second);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_B,params));
+            return getTemporalFormula(TF_DIAMOND_B,existing);
         }
         // No 'break' necessary, since the previous command is a return statement
     }
@@ -285,90 +274,231 @@ int FormulaFactory::encodeDerivedTemporalOperators(int startingFormula) {
     {
         // To things a bit smarter: as we have two possible encoding ([B][E] and [E][B]), check if we already have
         // one present and use that one then.
-        auto it = formulaNrs.find(boost::make_tuple(TF_BOX_E,res));
-        if (it==formulaNrs.end()) {
+        int existing = findSubformula(TF_BOX_E,res);
+        if (existing==NO_SUBFORMULA) {
             // Let's do [E][B] then
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_B,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_E,params));
+            int aSubFormula = insertSubformula(TF_BOX_B,res);
+            return getTemporalFormula(TF_BOX_E,aSubFormula);
         } else {
             // Let's do [B][E] -- the latter is already present
-            std::set<int> params;
-            params.insert(it->second);
-            return insertSubformula(boost::make_tuple(TF_BOX_B,params));
+            return getTemporalFormula(TF_BOX_B,existing);
         }
         // No 'break' necessary, since the previous command is a return statement
     }
     case TF_DIAMOND_O_BAR:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_E_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_B,params));
+            int aSubFormula = insertSubformula(TF_DIAMOND_E_BAR,res);
+            return getTemporalFormula(TF_DIAMOND_B,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_BOX_O_BAR:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_E_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_B,params));
+            int aSubFormula = insertSubformula(TF_BOX_E_BAR,res);
+            return getTemporalFormula(TF_BOX_B,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_DIAMOND_L_BAR:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_A_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_A_BAR,params));
+            int aSubFormula = insertSubformula(TF_DIAMOND_A_BAR,res);
+            return getTemporalFormula(TF_DIAMOND_A_BAR,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_BOX_L_BAR:
         {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_A_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_A_BAR,params));
+            int aSubFormula = insertSubformula(TF_BOX_A_BAR,res);
+            return getTemporalFormula(TF_BOX_A_BAR,aSubFormula);
         }
         // No 'break' necessary, since the previous command is a return statement
     case TF_DIAMOND_D_BAR:
     {
         // See above
-        auto it = formulaNrs.find(boost::make_tuple(TF_DIAMOND_E_BAR,res));
-        if (it==formulaNrs.end()) {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_DIAMOND_B_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_E_BAR,params));
+        int existing = findSubformula(TF_DIAMOND_E_BAR,res);
+        if (existing==NO_SUBFORMULA) {
+            int aSubFormula = insertSubformula(TF_DIAMOND_B_BAR,res);
+            return getTemporalFormula(TF_DIAMOND_E_BAR,aSubFormula);
         } else {
-            std::set<int> params;
-            params.insert(it->second);
-            return insertSubformula(boost::make_tuple(TF_DIAMOND_B_BAR,params));
+            return getTemporalFormula(TF_DIAMOND_B_BAR,existing);
         }
         // No 'break' necessary, since the previous command is a return statement
     }
     case TF_BOX_D_BAR:
     {
         // See above
-        auto it = formulaNrs.find(boost::make_tuple(TF_BOX_E_BAR,res));
-        if (it==formulaNrs.end()) {
-            int aSubFormula = insertSubformula(boost::make_tuple(TF_BOX_B_BAR,res));
-            std::set<int> params;
-            params.insert(aSubFormula);
-            return insertSubformula(boost::make_tuple(TF_BOX_E_BAR,params));
+        int existing = findSubformula(TF_BOX_E_BAR,res);
+        if (existing==NO_SUBFORMULA) {
+            int aSubFormula = insertSubformula(TF_BOX_B_BAR,res);
+            return getTemporalFormula(TF_BOX_E_BAR,aSubFormula);
         } else {
-            std::set<int> params;
-            params.insert(it->second);
-            return insertSubformula(boost::make_tuple(TF_BOX_B_BAR,params));
+            return getTemporalFormula(TF_BOX_B_BAR,existing);
         }
         // No 'break' necessary, since the previous command is a return statement
     }
     default:
-        return insertSubformula(boost::make_tuple(formulas[startingFormula].get<0>(),res));
+        return insertSubformula(formulas[startingFormula].type,res);
     }
 }
 
+/**
+ * @brief Determines the type of the partner subformula that the SAT encoding of a temporal operator refers to. The
+ *        partner has the same parameter as the subformula itself, and is added by the SAT checker before encoding.
+ * @return false if the operator does not need a partner
+ */
+bool FormulaFactory::getEncodingPartnerType(FormulaType type, FormulaType &partnerType) {
+    switch (type) {
+    case TF_DIAMOND_A:
+    case TF_DIAMOND_L:
+    case TF_DIAMOND_O:
+        partnerType = TF_DIAMOND_B_BAR; return true;
+    case TF_DIAMOND_A_BAR:
+    case TF_DIAMOND_L_BAR:
+    case TF_DIAMOND_O_BAR:
+        partnerType = TF_DIAMOND_E_BAR; return true;
+    case TF_BOX_A:
+    case TF_BOX_L:
+    case TF_BOX_O:
+        partnerType = TF_BOX_B_BAR; return true;
+    case TF_BOX_A_BAR:
+    case TF_BOX_L_BAR:
+    case TF_BOX_O_BAR:
+        partnerType = TF_BOX_E_BAR; return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Checks if a subformula is a conjunction (or disjunction) that contains an atomic proposition and its negation,
+ *        which is how the constant FALSE (or TRUE) is written in the input language.
+ */
+bool FormulaFactory::isConstant(int nr, FormulaType junctionType) const {
+    if ((nr<0) || (formulas[nr].type!=junctionType)) return false;
+    FormulaChildren children = getChildren(nr);
+    for (auto it = children.begin();it!=children.end();it++) {
+        if ((*it>=0) && (formulas[*it].type==TF_NOT) && (children.count(getSingleParameterOfTemporalSubformula(*it))>0)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Simplifies a formula in positive normal form. Nested conjunctions and disjunctions are flattened into n-ary
+ *        ones, the constants TRUE and FALSE (written as "p | !p" and "p & !p") are propagated, and subformulas that are
+ *        absorbed by a sibling in a conjunction or disjunction are removed.
+ *        As every remaining subformula gets its own SAT variables for every interval, this reduces the encoding size.
+ * @param startingFormula the formula to be simplified
+ * @return the new handle of the starting formula. The old subformulas are left in the table and can be removed by
+ *         "removeUnreachableSubformulas".
+ */
+int FormulaFactory::simplify(int startingFormula) {
+    std::vector<int> cache(formulas.size(),NO_SUBFORMULA);
+    return simplifyRecursively(startingFormula,cache);
+}
+
+int FormulaFactory::simplifyRecursively(int nr, std::vector<int> &cache) {
+    if (nr<0) return nr;
+    if (cache[nr]!=NO_SUBFORMULA) return cache[nr];
+
+    std::vector<int> children;
+    FormulaChildren from = getChildren(nr);
+    for (auto it = from.begin();it!=from.end();it++) {
+        children.push_back(simplifyRecursively(*it,cache));
+    }
+
+    FormulaType type = formulas[nr].type;
+    int result;
+    switch (type) {
+    case TF_AND:
+    case TF_OR:
+        result = simplifyJunction(type,children);
+        break;
+    case TF_NOT:
+        result = insertSubformula(type,children);
+        break;
+    default:
+        // Temporal operators: [X]TRUE is TRUE and <X>FALSE is FALSE
+        assert(children.size()==1);
+        if (isConstant(children[0],(type>=FIRST_BOX_FORMULA_TYPE)?TF_OR:TF_AND)) {
+            result = children[0];
+        } else {
+            result = getTemporalFormula(type,children[0]);
+        }
+    }
+    cache[nr] = result;
+    return result;
+}
+
+int FormulaFactory::simplifyJunction(FormulaType type, std::vector<int> &children) {
+    FormulaType dualType = (type==TF_AND)?TF_OR:TF_AND;
+
+    // Flatten nested junctions of the same type. Constants are flattened as well, as the complementary literals then
+    // make the junction constant again.
+    std::vector<int> flattened;
+    for (auto it = children.begin();it!=children.end();it++) {
+        if ((*it>=0) && (formulas[*it].type==type)) {
+            FormulaChildren grandChildren = getChildren(*it);
+            flattened.insert(flattened.end(),grandChildren.begin(),grandChildren.end());
+        } else {
+            flattened.push_back(*it);
+        }
+    }
+    std::sort(flattened.begin(),flattened.end());
+    flattened.erase(std::unique(flattened.begin(),flattened.end()),flattened.end());
+    FormulaChildren all(flattened.data(),flattened.size());
+
+    // Complementary literals: "p & !p" is FALSE and "p | !p" is TRUE
+    for (auto it = flattened.begin();it!=flattened.end();it++) {
+        if ((*it>=0) && (formulas[*it].type==TF_NOT) && (all.count(getSingleParameterOfTemporalSubformula(*it))>0)) {
+            int literal = getSingleParameterOfTemporalSubformula(*it);
+            return (type==TF_AND)?getAnd(literal,*it):getOr(literal,*it);
+        }
+    }
+
+    std::vector<int> result;
+    int neutralConstant = NO_SUBFORMULA;
+    for (auto it = flattened.begin();it!=flattened.end();it++) {
+        int child = *it;
+
+        // A constant of the dual type is the neutral element (TRUE in a conjunction and FALSE in a disjunction)
+        if (isConstant(child,dualType)) {
+            neutralConstant = child;
+            continue;
+        }
+
+        // Propositional absorption: "a & (a | b)" is "a", and "a | (a & b)" is "a"
+        if ((child>=0) && (formulas[child].type==dualType)) {
+            FormulaChildren dualChildren = getChildren(child);
+            bool absorbed = false;
+            for (auto it2 = dualChildren.begin();it2!=dualChildren.end();it2++) {
+                if (all.count(*it2)>0) absorbed = true;
+            }
+            if (absorbed) continue;
+        }
+
+        // Temporal absorption for the transitive operators B, E, D, L, and their inverses: "[X]a & [X][X]a" is "[X]a",
+        // and "<X>a | <X><X>a" is "<X>a"
+        if (child>=0) {
+            FormulaType childType = formulas[child].type;
+            bool transitive = (childType==TF_DIAMOND_B) || (childType==TF_DIAMOND_E) || (childType==TF_DIAMOND_B_BAR) || (childType==TF_DIAMOND_E_BAR)
+                || (childType==TF_DIAMOND_D) || (childType==TF_DIAMOND_D_BAR) || (childType==TF_DIAMOND_L) || (childType==TF_DIAMOND_L_BAR)
+                || (childType==TF_BOX_B) || (childType==TF_BOX_E) || (childType==TF_BOX_B_BAR) || (childType==TF_BOX_E_BAR)
+                || (childType==TF_BOX_D) || (childType==TF_BOX_D_BAR) || (childType==TF_BOX_L) || (childType==TF_BOX_L_BAR);
+            bool matchingJunction = (childType>=FIRST_BOX_FORMULA_TYPE)==(type==TF_AND);
+            if (transitive && matchingJunction) {
+                int inner = getSingleParameterOfTemporalSubformula(child);
+                if ((inner>=0) && (formulas[inner].type==childType) && (all.count(inner)>0)) continue;
+            }
+        }
+
+        result.push_back(child);
+    }
+
+    if (result.size()==0) {
+        assert(neutralConstant!=NO_SUBFORMULA);
+        return neutralConstant;
+    }
+    if (result.size()==1) return result[0];
+    return insertSortedSubformula(type,result.data(),result.size());
+}
+
 /**
  * @brief Removes all subformulas that are unreachable from the given starting formula
  * @param startingFormula the only formula that is considered to be reachable by default
@@ -376,185 +506,264 @@ int FormulaFactory::encodeDerivedTemporalOperators(int startingFormula) {
  */
 int FormulaFactory::removeUnreachableSubformulas(int startingFormula) {
 
-    // Obtain list of reachable subformulas
-    std::set<int> todo;
-    std::set<int> reachable;
-    todo.insert(startingFormula);
-    reachable.insert(startingFormula);
-    while (todo.size()>0) {
-        int thisOne = *(todo.begin());
-        todo.erase(*(todo.begin()));
-        if (thisOne>=0) {
-            std::set<int> currentOne = formulas[thisOne].get<1>();
-            for (auto it = currentOne.begin();it!=currentOne.end();it++) {
-                if (reachable.count(*it)==0) {
-                    reachable.insert(*it);
-                    todo.insert(*it);
-                }
+    if (startingFormula<0) {
+        formulas.clear();
+        rehash(formulaSlots.size());
+        return startingFormula;
+    }
+
+    // Obtain list of reachable subformulas. As subformulas can only be built from existing ones, the children of
+    // a subformula always have smaller numbers, so a single pass downwards from the starting formula suffices.
+    std::vector<bool> reachable(startingFormula+1,false);
+    reachable[startingFormula] = true;
+    for (int thisOne=startingFormula;thisOne>=0;thisOne--) {
+        if (reachable[thisOne]) {
+            for (unsigned int i=0;i<formulas[thisOne].nofChildren;i++) {
+                int child = formulas[thisOne].children[i];
+                if (child>=0) reachable[child] = true;
             }
         }
     }
 
     // Compute mapping
-    std::map<int,int> mapping;
-    for (auto it = reachable.begin();it!=reachable.end();it++) {
-        if (*it>=0) {
-            int newValue = mapping.size();
-            mapping[*it] = newValue;
-        }
+    std::vector<int> mapping(startingFormula+1,-1);
+    int nofReachable = 0;
+    for (int i=0;i<=startingFormula;i++) {
+        if (reachable[i]) mapping[i] = nofReachable++;
     }
 
-    // Rebuild formulas. Totally rebuild the "formulaNrs" map, and only shorten the vector
-    std::map<boost::tuple<FormulaType,std::set<int> >,int,FormulaNrsComparator> formulaNrsNew;
-    for (auto it = mapping.begin();it!=mapping.end();it++) {
-        std::set<int> &old = formulas[it->first].get<1>();
-        std::set<int> newOne;
-        for (auto it2 = old.begin();it2!=old.end();it2++) {
-            // Handle atomic propositions (those with a value < 0) differently
-            if (*it2<0) {
-                newOne.insert(*it2);
-            } else {
-                newOne.insert(mapping[*it2]);
+    // Rebuild formulas. The mapping preserves the order of the subformulas, so the children of each subformula stay
+    // sorted and re-inserting the reachable subformulas in their old order gives them their new numbers.
+    std::vector<FormulaNode> oldFormulas;
+    std::vector<boost::shared_array<int> > oldArenaBlocks;
+    oldFormulas.swap(formulas);
+    oldArenaBlocks.swap(arenaBlocks);
+    arenaBlockUsed = 0;
+    arenaBlockSize = 0;
+    rehash(formulaSlots.size());
+    std::vector<int> newChildren;
+    for (int i=0;i<=startingFormula;i++) {
+        if (reachable[i]) {
+            newChildren.clear();
+            for (unsigned int j=0;j<oldFormulas[i].nofChildren;j++) {
+                // Handle atomic propositions (those with a value < 0) differently
+                int child = oldFormulas[i].children[j];
+                newChildren.push_back((child<0)?child:mapping[child]);
             }
+            int newNr = insertSortedSubformula(oldFormulas[i].type,newChildren.data(),newChildren.size());
+            assert(newNr==mapping[i]);
+            (void)newNr;
         }
-        auto newTuple = boost::make_tuple(formulas[it->first].get<0>(),newOne);
-        formulas[it->second] = newTuple;
-        formulaNrsNew[newTuple] = it->second;
-        //std::cout << "formulaNrsNew Add: "  << it->second << std::endl;
     }
 
-    formulaNrs = formulaNrsNew;
-    formulas.resize(mapping.size());
+    return mapping[startingFormula];
+}
 
-    if (startingFormula<0) return startingFormula;
-    return mapping.at(startingFormula);
+const int FormulaFactory::NO_SUBFORMULA = std::numeric_limits<int>::min();
 
+FormulaFactory::FormulaFactory() : arenaBlockUsed(0), arenaBlockSize(0) {
+    formulaSlots.resize(256,0);
 }
 
-int FormulaFactory::insertSubformula(const boost::tuple<FormulaType,std::set<int> > &searchingFor) {
-    std::map<boost::tuple<FormulaType,std::set<int> >,int>::iterator it = formulaNrs.find(searchingFor);
-    if (it==formulaNrs.end()) {
-        assert(formulaNrs.count(searchingFor)==0);
-        int newNr = formulas.size();
-        formulas.push_back(searchingFor);
-        formulaNrs[searchingFor] = newNr;
-        return newNr;
-    } else {
-        return it->second;
+size_t FormulaFactory::computeHash(FormulaType type, const int *children, unsigned int nofChildren) {
+    size_t hash = 0;
+    boost::hash_combine(hash,(int)type);
+    for (unsigned int i=0;i<nofChildren;i++) {
+        boost::hash_combine(hash,children[i]);
+    }
+    return hash;
+}
+
+const int *FormulaFactory::copyToArena(const int *children, unsigned int nofChildren) {
+    if ((arenaBlocks.size()==0) || (arenaBlockUsed+nofChildren>arenaBlockSize)) {
+        arenaBlockSize = std::max((size_t)16384,(size_t)nofChildren);
+        arenaBlocks.push_back(boost::shared_array<int>(new int[arenaBlockSize]));
+        arenaBlockUsed = 0;
     }
+    int *destination = arenaBlocks.back().get()+arenaBlockUsed;
+    std::copy(children,children+nofChildren,destination);
+    arenaBlockUsed += nofChildren;
+    return destination;
+}
+
+/**
+ * @brief Returns the number of bytes used by the formula table, the hash table and the arena (counting every arena block
+ *        but the last one with the default block size)
+ */
+size_t FormulaFactory::getMemoryUsage() const {
+    size_t bytes = formulas.capacity()*sizeof(FormulaNode)+formulaSlots.capacity()*sizeof(int);
+    if (arenaBlocks.size()>0) bytes += ((arenaBlocks.size()-1)*16384+arenaBlockSize)*sizeof(int);
+    return bytes;
+}
+
+void FormulaFactory::rehash(size_t newSize) {
+    formulaSlots.assign(newSize,0);
+    for (unsigned int i=0;i<formulas.size();i++) {
+        size_t position = formulas[i].hash & (newSize-1);
+        while (formulaSlots[position]!=0) position = (position+1) & (newSize-1);
+        formulaSlots[position] = i+1;
+    }
+}
+
+/**
+ * @brief Looks up a subformula, and adds it if it is not present yet.
+ * @param children the children of the subformula, which must be sorted and must not contain duplicates
+ * @return the number of the subformula
+ */
+int FormulaFactory::insertSortedSubformula(FormulaType type, const int *children, unsigned int nofChildren) {
+    size_t hash = computeHash(type,children,nofChildren);
+    size_t mask = formulaSlots.size()-1;
+    size_t position = hash & mask;
+    while (formulaSlots[position]!=0) {
+        const FormulaNode &node = formulas[formulaSlots[position]-1];
+        if ((node.hash==hash) && (node.type==type) && (node.nofChildren==nofChildren) && std::equal(children,children+nofChildren,node.children)) {
+            return formulaSlots[position]-1;
+        }
+        position = (position+1) & mask;
+    }
+    FormulaNode node;
+    node.type = type;
+    node.nofChildren = nofChildren;
+    node.children = copyToArena(children,nofChildren);
+    node.hash = hash;
+    int newNr = formulas.size();
+    formulas.push_back(node);
+    formulaSlots[position] = newNr+1;
+    if (formulas.size()*2>formulaSlots.size()) rehash(formulaSlots.size()*2);
+    return newNr;
+}
+
+/**
+ * @brief Looks up a subformula, and adds it if it is not present yet.
+ * @param children the children of the subformula, in any order. The vector is sorted by this function.
+ * @return the number of the subformula
+ */
+int FormulaFactory::insertSubformula(FormulaType type, std::vector<int> &children) {
+    std::sort(children.begin(),children.end());
+    children.erase(std::unique(children.begin(),children.end()),children.end());
+    return insertSortedSubformula(type,children.data(),children.size());
+}
+
+/**
+ * @brief Looks up a subformula without adding it
+ * @return the number of the subformula, or NO_SUBFORMULA if it is not present
+ */
+int FormulaFactory::findSubformula(FormulaType type, const FormulaChildren &children) const {
+    size_t hash = computeHash(type,children.begin(),children.size());
+    size_t mask = formulaSlots.size()-1;
+    size_t position = hash & mask;
+    while (formulaSlots[position]!=0) {
+        const FormulaNode &node = formulas[formulaSlots[position]-1];
+        if ((node.hash==hash) && (node.type==type) && (node.nofChildren==children.size()) && std::equal(children.begin(),children.end(),node.children)) {
+            return formulaSlots[position]-1;
+        }
+        position = (position+1) & mask;
+    }
+    return NO_SUBFORMULA;
+}
+
+int FormulaFactory::findSubformula(FormulaType type, std::vector<int> &children) const {
+    std::sort(children.begin(),children.end());
+    children.erase(std::unique(children.begin(),children.end()),children.end());
+    return findSubformula(type,FormulaChildren(children.data(),children.size()));
 }
 
 int FormulaFactory::getOr(int a, int b) {
-    std::set<int> res;
-    res.insert(a);
-    res.insert(b);
-    boost::tuple<FormulaType,std::set<int> > searchingFor = boost::make_tuple(TF_OR,res);
-    std::map<boost::tuple<FormulaType,std::set<int> >,int>::iterator it = formulaNrs.find(searchingFor);
-    return insertSubformula(searchingFor);
+    int children[2] = {std::min(a,b),std::max(a,b)};
+    return insertSortedSubformula(TF_OR,children,(a==b)?1:2);
 }
 
 int FormulaFactory::getAnd(int a, int b) {
-    std::set<int> res;
-    res.insert(a);
-    res.insert(b);
-    boost::tuple<FormulaType,std::set<int> > searchingFor = boost::make_tuple(TF_AND,res);
-    return insertSubformula(searchingFor);
+    int children[2] = {std::min(a,b),std::max(a,b)};
+    return insertSortedSubformula(TF_AND,children,(a==b)?1:2);
 }
 
 int FormulaFactory::getNot(int a) {
-    std::set<int> res;
-    res.insert(a);
-    boost::tuple<FormulaType,std::set<int> > searchingFor = boost::make_tuple(TF_NOT,res);
-    std::map<boost::tuple<FormulaType,std::set<int> >,int>::iterator it = formulaNrs.find(searchingFor);
-    return insertSubformula(searchingFor);
+    return insertSortedSubformula(TF_NOT,&a,1);
 }
 
-int FormulaFactory::getDiamondTemporalFormula(std::string *op, int a) {
-    std::set<int> res;
+FormulaType FormulaFactory::getDiamondOperatorType(const std::string &op) {
     FormulaType ft;
-    if (*op=="a" || *op=="A") {
+    if (op=="a" || op=="A") {
         ft = TF_DIAMOND_A;
-    } else if (*op=="b" || *op=="B") {
+    } else if (op=="b" || op=="B") {
         ft = TF_DIAMOND_B;
-    } else if (*op=="e" || *op=="E") {
+    } else if (op=="e" || op=="E") {
         ft = TF_DIAMOND_E;
-    } else if (*op=="l" || *op=="L") {
+    } else if (op=="l" || op=="L") {
         ft = TF_DIAMOND_L;
-    } else if (*op=="d" || *op=="D") {
+    } else if (op=="d" || op=="D") {
         ft = TF_DIAMOND_D;
-    } else if (*op=="o" || *op=="O") {
+    } else if (op=="o" || op=="O") {
         ft = TF_DIAMOND_O;
-    } else if (*op=="a'" || *op=="A'") {
+    } else if (op=="a'" || op=="A'") {
         ft = TF_DIAMOND_A_BAR;
-    } else if (*op=="b'" || *op=="B'") {
+    } else if (op=="b'" || op=="B'") {
         ft = TF_DIAMOND_B_BAR;
-    } else if (*op=="e'" || *op=="E'") {
+    } else if (op=="e'" || op=="E'") {
         ft = TF_DIAMOND_E_BAR;
-    } else if (*op=="l'" || *op=="L'") {
+    } else if (op=="l'" || op=="L'") {
         ft = TF_DIAMOND_L_BAR;
-    } else if (*op=="d'" || *op=="D'") {
+    } else if (op=="d'" || op=="D'") {
         ft = TF_DIAMOND_D_BAR;
-    } else if (*op=="o'" || *op=="O'") {
+    } else if (op=="o'" || op=="O'") {
         ft = TF_DIAMOND_O_BAR;
     } else {
-        throw std::string("Did not understand the temporal operator <")+*op+">";
+        throw std::string("Did not understand the temporal operator <")+op+">";
     }
-    res.insert(a);
-    boost::tuple<FormulaType,std::set<int> > searchingFor = boost::make_tuple(ft,res);
-    return insertSubformula(searchingFor);
+    return ft;
 }
 
-int FormulaFactory::getBoxTemporalFormula(std::string *op, int a) {
-    std::set<int> res;
+FormulaType FormulaFactory::getBoxOperatorType(const std::string &op) {
     FormulaType ft;
-    if (*op=="a" || *op=="A") {
+    if (op=="a" || op=="A") {
         ft = TF_BOX_A;
-    } else if (*op=="b" || *op=="B") {
+    } else if (op=="b" || op=="B") {
         ft = TF_BOX_B;
-    } else if (*op=="e" || *op=="E") {
+    } else if (op=="e" || op=="E") {
         ft = TF_BOX_E;
-    } else if (*op=="o" || *op=="O") {
+    } else if (op=="o" || op=="O") {
         ft = TF_BOX_O;
-    } else if (*op=="l" || *op=="L") {
+    } else if (op=="l" || op=="L") {
         ft = TF_BOX_L;
-    } else if (*op=="d" || *op=="D") {
+    } else if (op=="d" || op=="D") {
         ft = TF_BOX_D;
-    } else if (*op=="a'" || *op=="A'") {
+    } else if (op=="a'" || op=="A'") {
         ft = TF_BOX_A_BAR;
-    } else if (*op=="b'" || *op=="B'") {
+    } else if (op=="b'" || op=="B'") {
         ft = TF_BOX_B_BAR;
-    } else if (*op=="e'" || *op=="E'") {
+    } else if (op=="e'" || op=="E'") {
         ft = TF_BOX_E_BAR;
-    } else if (*op=="o'" || *op=="O'") {
+    } else if (op=="o'" || op=="O'") {
         ft = TF_BOX_O_BAR;
-    } else if (*op=="l'" || *op=="L'") {
+    } else if (op=="l'" || op=="L'") {
         ft = TF_BOX_L_BAR;
-    } else if (*op=="d'" || *op=="D'") {
+    } else if (op=="d'" || op=="D'") {
         ft = TF_BOX_D_BAR;
-    } else if (*op=="e'" || *op=="E'") {
+    } else if (op=="e'" || op=="E'") {
         ft = TF_BOX_E_BAR;
     } else {
-        throw std::string("Did not understand the temporal operator [")+*op+"]";
+        throw std::string("Did not understand the temporal operator [")+op+"]";
     }
-    res.insert(a);
-    boost::tuple<FormulaType,std::set<int> > searchingFor = boost::make_tuple(ft,res);
-    return insertSubformula(searchingFor);
+    return ft;
 }
 
-int FormulaFactory::getPropositionalFormula(std::string *name) {
-    std::map<std::string,int>::iterator finder = apNrs.find(*name);
+int FormulaFactory::getTemporalFormula(FormulaType type, int a) {
+    return insertSortedSubformula(type,&a,1);
+}
+
+int FormulaFactory::getPropositionalFormula(const std::string &name) {
+    std::map<std::string,int>::iterator finder = apNrs.find(name);
     if (finder==apNrs.end()) {
         int apNumber = -aps.size()-1;
-        aps.push_back(*name);
-        apNrs[*name] = apNumber;
+        aps.push_back(name);
+        apNrs[name] = apNumber;
         return apNumber;
     }
     return finder->second;
 }
 
-int FormulaFactory::getSingleParameterOfTemporalSubformula(int number) {
-    std::set<int> &params = formulas[number].get<1>();
-    assert(params.size()==1);
-    int result = *params.begin();
-    return result;
+int FormulaFactory::getSingleParameterOfTemporalSubformula(int number) const {
+    assert(formulas[number].nofChildren==1);
+    return formulas[number].children[0];
 }
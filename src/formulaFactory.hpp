@@ -9,8 +9,6 @@
 #include <algorithm>
 #include <iostream>
 #include <boost/smart_ptr.hpp>
-#include <boost/tuple/tuple.hpp>
-#include <boost/tuple/tuple_comparison.hpp>
 
 /**
   * @brief The possible types of subformulas in a temporal formula.
@@ -25,9 +23,32 @@ typedef enum { TF_AND, TF_OR, TF_NOT, TF_DIAMOND_A, TF_DIAMOND_B, TF_DIAMOND_E,
 std::ostream& operator<<(std::ostream& lhs, FormulaType e);
 
 
+/**
+ * @brief The children of a subformula, as a sorted array without duplicates. The array is stored in the arena of the
+ *        formula factory, so it remains valid when further subformulas are added, but not after
+ *        "removeUnreachableSubformulas" has been called.
+ */
+class FormulaChildren {
+private:
+    const int *first;
+    unsigned int length;
+public:
+    typedef const int *const_iterator;
+    FormulaChildren(const int *_first, unsigned int _length) : first(_first), length(_length) {}
+    const_iterator begin() const { return first; }
+    const_iterator end() const { return first+length; }
+    unsigned int size() const { return length; }
+    unsigned int count(int element) const { return std::binary_search(first,first+length,element)?1:0; }
+    int operator[](unsigned int index) const { return first[index]; }
+};
+
 /**
  * @brief FormulaFactory class that represents formulas as integers. Atomic propositions have negative numbers, all numbers 0 and
  * above represent proper formulas.
+ *
+ * Subformulas are hash-consed: every node is stored only once, and the children of a node are sorted arrays in an arena
+ * of large blocks. Nodes are found by their structural hash in an open-addressing hash table with linear probing, so
+ * looking up or adding a subformula does not allocate memory except for growing the tables.
  */
 class FormulaFactory {
 private:
@@ -35,41 +56,60 @@ private:
     std::vector<std::string> aps;
     std::map<std::string,int> apNrs;
 
-    // Two-way lookup structures for formulas
-    class FormulaNrsComparator {
-    public:
-        bool operator()(const boost::tuple<FormulaType,std::set<int> >& left, const boost::tuple<FormulaType,std::set<int> >& right) const {
-            if (left.get<0>() < right.get<0>()) return true;
-            if (left.get<0>() > right.get<0>()) return false;
-            return std::lexicographical_compare(left.get<1>().begin(),left.get<1>().end(),right.get<1>().begin(),right.get<1>().end());
-        }
+    // Formula nodes and the hash table for finding them. The slots contain formula numbers+1, or 0 for free slots.
+    struct FormulaNode {
+        FormulaType type;
+        unsigned int nofChildren;
+        const int *children;
+        size_t hash;
     };
+    std::vector<FormulaNode> formulas;
+    std::vector<int> formulaSlots;
+
+    // Arena for the children of the nodes
+    std::vector<boost::shared_array<int> > arenaBlocks;
+    size_t arenaBlockUsed;
+    size_t arenaBlockSize;
 
-    std::vector<boost::tuple<FormulaType,std::set<int> > > formulas;
-    std::map<boost::tuple<FormulaType,std::set<int> >,int,FormulaNrsComparator> formulaNrs;
+    static size_t computeHash(FormulaType type, const int *children, unsigned int nofChildren);
+    const int *copyToArena(const int *children, unsigned int nofChildren);
+    void rehash(size_t newSize);
+    int insertSortedSubformula(FormulaType type, const int *children, unsigned int nofChildren);
+    bool isConstant(int nr, FormulaType junctionType) const;
+    int simplifyRecursively(int nr, std::vector<int> &cache);
+    int simplifyJunction(FormulaType type, std::vector<int> &children);
 
 public:
-    FormulaFactory() {}
-    int insertSubformula(const boost::tuple<FormulaType,std::set<int> > &searchingFor);
+    static const int NO_SUBFORMULA;
+
+    FormulaFactory();
+    int insertSubformula(FormulaType type, const FormulaChildren &children) { return insertSortedSubformula(type,children.begin(),children.size()); }
+    int insertSubformula(FormulaType type, std::vector<int> &children);
+    int findSubformula(FormulaType type, const FormulaChildren &children) const;
+    int findSubformula(FormulaType type, std::vector<int> &children) const;
     int getOr(int a, int b);
     int getAnd(int a, int b);
     int getNot(int a);
-    int getDiamondTemporalFormula(std::string *type, int subformula);
-    int getBoxTemporalFormula(std::string *type, int subformula);
-    int getPropositionalFormula(std::string *name);
-    void printFormula(int nr, int level=0);
-    int getSingleParameterOfTemporalSubformula(int number);
+    static FormulaType getDiamondOperatorType(const std::string &type);
+    static FormulaType getBoxOperatorType(const std::string &type);
+    static bool getEncodingPartnerType(FormulaType type, FormulaType &partnerType);
+    int getTemporalFormula(FormulaType type, int subformula);
+    int getDiamondTemporalFormula(const std::string &type, int subformula) { return getTemporalFormula(getDiamondOperatorType(type),subformula); }
+    int getBoxTemporalFormula(const std::string &type, int subformula) { return getTemporalFormula(getBoxOperatorType(type),subformula); }
+    int getPropositionalFormula(const std::string &name);
+    void printFormula(int nr, int level=0) const;
+    int getSingleParameterOfTemporalSubformula(int number) const;
     int encodeDerivedTemporalOperators(int startingFormula);
     int removeUnreachableSubformulas(int startingFormula);
     int makePositiveNormalForm(int startingFormula, bool negated = false);
+    int simplify(int startingFormula);
     void printFormulaTable();
 
-    const std::map<std::string,int> &getAPNrs() { return apNrs; }
-    const std::map<boost::tuple<FormulaType,std::set<int> >,int,FormulaNrsComparator> &getFormulaNrs() { return formulaNrs; }
-    const std::vector<boost::tuple<FormulaType,std::set<int> > > &getFormulas() { return formulas; }
+    const std::map<std::string,int> &getAPNrs() const { return apNrs; }
+    unsigned int getNofFormulas() const { return formulas.size(); }
+    size_t getMemoryUsage() const;
+    FormulaType getFormulaType(int nr) const { return formulas[nr].type; }
+    FormulaChildren getChildren(int nr) const { return FormulaChildren(formulas[nr].children,formulas[nr].nofChildren); }
 };
 
-extern FormulaFactory formulaFactory;
-
 #endif
-
@@ -0,0 +1,119 @@
+#include "icnfWriter.hpp"
+#include <cstring>
+
+/**
+ * @brief Opens the iCNF file and its variable map, and throws if they cannot be created. The solver is not owned by
+ *        the writer, but must outlive it.
+ */
+ICNFWriter::ICNFWriter(IncrementalSATSolver &_solver, const std::string &_filename) : solver(_solver), filename(_filename) {
+    file = NULL;
+    compressedFile = NULL;
+    mapFile = NULL;
+    buffer.resize(1 << 20);
+    bufferUsed = 0;
+
+    std::string mapFilename = filename;
+    if ((filename.size()>3) && (filename.substr(filename.size()-3)==".gz")) {
+        compressedFile = gzopen(filename.c_str(),"wb");
+        if (compressedFile==NULL) throw std::string("Cannot write to the file '")+filename+"'.";
+        mapFilename = filename.substr(0,filename.size()-3);
+    } else {
+        file = fopen(filename.c_str(),"wb");
+        if (file==NULL) throw std::string("Cannot write to the file '")+filename+"'.";
+    }
+    mapFilename += ".map";
+    mapFile = fopen(mapFilename.c_str(),"w");
+    if (mapFile==NULL) {
+        if (file!=NULL) fclose(file);
+        if (compressedFile!=NULL) gzclose(compressedFile);
+        throw std::string("Cannot write to the file '")+mapFilename+"'.";
+    }
+    write("p inccnf\n");
+}
+
+ICNFWriter::~ICNFWriter() {
+    try {
+        flush();
+    } catch (std::string) {
+        // Destructors must not throw, and the file is incomplete anyway
+    }
+    if (file!=NULL) fclose(file);
+    if (compressedFile!=NULL) gzclose(compressedFile);
+    fclose(mapFile);
+}
+
+void ICNFWriter::flush() {
+    if (bufferUsed==0) return;
+    bool success;
+    if (compressedFile!=NULL) {
+        success = gzwrite(compressedFile,buffer.data(),bufferUsed)==(int)bufferUsed;
+    } else {
+        success = fwrite(buffer.data(),1,bufferUsed,file)==bufferUsed;
+    }
+    bufferUsed = 0;
+    if (!success) throw std::string("Error writing to the file '")+filename+"'.";
+}
+
+void ICNFWriter::write(const char *text, size_t length) {
+    if (bufferUsed+length>buffer.size()) flush();
+    if (length>buffer.size()) buffer.resize(length);
+    memcpy(buffer.data()+bufferUsed,text,length);
+    bufferUsed += length;
+}
+
+/**
+ * @brief Writes a number followed by a space (or, for 0, a line break). Clauses are written number by number, so this
+ *        avoids the overhead of the C++ streams.
+ */
+void ICNFWriter::writeNumber(long long number) {
+    char text[24];
+    char *end = text+sizeof(text);
+    char *start = end;
+    *--start = (number==0)?'\n':' ';
+    unsigned long long digits = (number<0)?-(unsigned long long)number:number;
+    do {
+        *--start = '0'+digits%10;
+        digits /= 10;
+    } while (digits!=0);
+    if (number<0) *--start = '-';
+    write(start,end-start);
+}
+
+void ICNFWriter::add(int literal) {
+    writeNumber(literal);
+    solver.add(literal);
+}
+
+void ICNFWriter::assume(int literal) {
+    assumptions.push_back(literal);
+    solver.assume(literal);
+}
+
+/**
+ * @brief Writes the assumptions of this call (which may be none) and passes the call on to the solver. The files are
+ *        flushed before, so that the instance up to the current bound can already be used while the solver runs.
+ */
+IncrementalSATSolver::Result ICNFWriter::solve() {
+    write("a ");
+    for (auto it = assumptions.begin();it!=assumptions.end();it++) writeNumber(*it);
+    writeNumber(0);
+    assumptions.clear();
+    flush();
+    if (compressedFile!=NULL) {
+        gzflush(compressedFile,Z_SYNC_FLUSH);
+    } else {
+        fflush(file);
+    }
+    fflush(mapFile);
+    return solver.solve();
+}
+
+void ICNFWriter::writeComment(const std::string &comment) {
+    write("c ");
+    write(comment);
+    write("\n");
+}
+
+void ICNFWriter::writeVariableMapping(int variable, const std::string &ap, int from, int to) {
+    fprintf(mapFile,"%d %s %d %d\n",variable,ap.c_str(),from,to);
+}
@@ -0,0 +1,53 @@
+#ifndef __ICNF_WRITER_HPP__
+#define __ICNF_WRITER_HPP__
+
+#include "satSolver.hpp"
+#include <vector>
+#include <cstdio>
+#include <zlib.h>
+
+/**
+ * @brief Wraps an incremental SAT solver and streams everything passed to it to a file in the iCNF format: a header
+ *        "p inccnf", the clauses in DIMACS syntax, and one line "a <assumptions> 0" for every call to "solve()". The
+ *        file can be given to any incremental SAT solver that reads iCNF, or be archived for benchmarking.
+ *
+ *        The output is collected in a buffer of fixed size that is written whenever it is full, so the instance is
+ *        never kept in memory as a whole. If the file name ends with ".gz", the file is compressed with zlib. The
+ *        variables of the atomic propositions are written to a plain text sidecar file (the file name without ".gz",
+ *        followed by ".map") as lines "<variable> <atomic proposition> <from> <to>", so that models can be mapped back
+ *        to the intervals on which the atomic propositions hold.
+ */
+class ICNFWriter : public IncrementalSATSolver {
+private:
+    IncrementalSATSolver &solver;
+    std::string filename;
+    FILE *file;
+    gzFile compressedFile;
+    FILE *mapFile;
+    std::vector<char> buffer;
+    size_t bufferUsed;
+    std::vector<int> assumptions;
+
+    void flush();
+    void write(const char *text, size_t length);
+    void write(const std::string &text) { write(text.data(),text.size()); }
+    void writeNumber(long long number);
+
+public:
+    ICNFWriter(IncrementalSATSolver &solver, const std::string &filename);
+    ~ICNFWriter();
+    void add(int literal);
+    void assume(int literal);
+    Result solve();
+    bool getValue(int literal) { return solver.getValue(literal); }
+    bool isFailedAssumption(int literal) { return solver.isFailedAssumption(literal); }
+    std::string getName() { return solver.getName(); }
+    Statistics getStatistics() { return solver.getStatistics(); }
+    bool setEffortLimit(long long limit) { return solver.setEffortLimit(limit); }
+    void setTerminateCallback(const std::function<bool()> &callback) { solver.setTerminateCallback(callback); }
+
+    void writeComment(const std::string &comment);
+    void writeVariableMapping(int variable, const std::string &ap, int from, int to);
+};
+
+#endif
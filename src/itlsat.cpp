@@ -0,0 +1,90 @@
+#include "itlsat.hpp"
+#include "parser.hpp"
+
+ITLSatContext::ITLSatContext() {
+    parsed = false;
+    formula = 0;
+    result.status = BoundSearchResult::NO_MODEL_UP_TO_MAX_BOUND;
+    result.bound = 0;
+    result.nofVariables = 0;
+    result.nofClauses = 0;
+    satSolverBackend = "picosat";
+    useActivationLiterals = false;
+    useSymmetryBreaking = false;
+    simplifyFormula = true;
+    nativeDerivedOperators = true;
+    cancelled = false;
+}
+
+void ITLSatContext::setParsedFormula(int parsedFormula) {
+    formula = SatisfiabilityChecker::prepareFormula(factory,parsedFormula,false,simplifyFormula,nativeDerivedOperators);
+    parsed = true;
+}
+
+void ITLSatContext::checkNotParsedYet() const {
+    if (parsed) {
+        throw std::string("A formula has already been parsed in this context.");
+    }
+}
+
+void ITLSatContext::parse(FILE *input) {
+    checkNotParsedYet();
+    setParsedFormula(parseFormula(factory,input));
+}
+
+void ITLSatContext::parse(const std::string &formulaText) {
+    checkNotParsedYet();
+    setParsedFormula(parseFormula(factory,formulaText.data(),formulaText.size()));
+}
+
+void ITLSatContext::parseFile(const std::string &filename) {
+    checkNotParsedYet();
+    setParsedFormula(parseFormulaFile(factory,filename));
+}
+
+/**
+ * @brief Searches for a model of minimal length up to the given bound (-1 for no bound). Can be called repeatedly with
+ *        increasing bounds, in which case the search continues where it stopped, unless it has been cancelled or has
+ *        reached a resource limit.
+ */
+const BoundSearchResult &ITLSatContext::check(int maxBound) {
+    if (!parsed) {
+        throw std::string("No formula has been parsed in this context.");
+    }
+    if (!checker) {
+        checker.reset(new SatisfiabilityChecker(factory,formula,satSolverBackend));
+        checker->setUseActivationLiterals(useActivationLiterals);
+        checker->setUseSymmetryBreaking(useSymmetryBreaking);
+        checker->setTerminateCallback([this]() { return cancelled.load(); });
+        checker->setResourceLimits(resourceLimits);
+        if (resultCacheDirectory!="") checker->setResultCache(resultCacheDirectory);
+    }
+    checker->setProgressCallback(progressCallback);
+    checker->setStatisticsCallback(statisticsCallback);
+    if (result.status==BoundSearchResult::CANCELLED) {
+        throw std::string("The check has been cancelled.");
+    } else if (result.status==BoundSearchResult::UNKNOWN) {
+        throw std::string("The check has been stopped by reaching the ")+checker->getResourceLimitReached()+".";
+    } else if ((result.status!=BoundSearchResult::SATISFIABLE) && (result.status!=BoundSearchResult::UNSATISFIABLE)) {
+        result = checker->searchMinimalModel(maxBound);
+    }
+    return result;
+}
+
+std::map<std::string,std::vector<std::pair<int,int> > > ITLSatContext::getModel() {
+    if (!checker || (result.status!=BoundSearchResult::SATISFIABLE)) {
+        throw std::string("No model has been found.");
+    }
+    return checker->getModel();
+}
+
+/**
+ * @brief Checks the model found with the "CertificateValidator", which evaluates the formula on it without using the SAT
+ *        encoding
+ */
+bool ITLSatContext::validateModel() {
+    if (!checker || (result.status!=BoundSearchResult::SATISFIABLE)) {
+        throw std::string("No model has been found.");
+    }
+    return checker->validateModel();
+}
@@ -0,0 +1,96 @@
+#ifndef __ITLSAT_HPP__
+#define __ITLSAT_HPP__
+
+#include "formulaFactory.hpp"
+#include "satChecker.hpp"
+#include <atomic>
+#include <cstdio>
+
+/**
+ * @brief Entry point for embedding the satisfiability checker in other programs (as "libitlsat"). A context owns the
+ *        formula factory, the parsed formula, and the checker, so independent contexts can be used in parallel threads.
+ *
+ *        Usage: "parse" a formula, then "check" it up to some bound, and read the outcome with "getResult" and, if a
+ *        model has been found, "getModel" (which can be checked independently of the SAT encoding with
+ *        "validateModel"). A context checks a single formula.
+ */
+class ITLSatContext {
+private:
+    FormulaFactory factory;
+    bool parsed;
+    int formula;
+    boost::scoped_ptr<SatisfiabilityChecker> checker;
+    BoundSearchResult result;
+
+    // Options
+    std::string satSolverBackend;
+    bool useActivationLiterals;
+    bool useSymmetryBreaking;
+    bool simplifyFormula;
+    bool nativeDerivedOperators;
+    ResourceLimits resourceLimits;
+    std::string resultCacheDirectory;
+    std::function<void(int,IncrementalSATSolver::Result)> progressCallback;
+    std::function<void(const BoundStatistics &)> statisticsCallback;
+    std::atomic<bool> cancelled;
+
+    void checkNotParsedYet() const;
+    void setParsedFormula(int parsedFormula);
+
+public:
+    ITLSatContext();
+    void parse(const std::string &formulaText);
+    void parse(FILE *input);
+    void parseFile(const std::string &filename);
+    const BoundSearchResult &check(int maxBound);
+    const BoundSearchResult &getResult() const { return result; }
+    std::map<std::string,std::vector<std::pair<int,int> > > getModel();
+    bool validateModel();
+
+    void setSatSolverBackend(const std::string &backend) { satSolverBackend = backend; }
+    void setUseActivationLiterals(bool value) { useActivationLiterals = value; }
+    void setUseSymmetryBreaking(bool value) { useSymmetryBreaking = value; }
+
+    /**
+     * @brief Sets whether the formula is simplified before it is encoded (default: true). Must be called before "parse".
+     */
+    void setSimplifyFormula(bool value) { simplifyFormula = value; }
+
+    /**
+     * @brief Sets whether the derived operators L, D, and O are encoded natively instead of being expressed by the
+     *        other operators (default: true). Must be called before "parse".
+     */
+    void setNativeDerivedOperators(bool value) { nativeDerivedOperators = value; }
+
+    /**
+     * @brief Sets limits on the time, the solver effort, and the memory of the check (by default, there are none). The
+     *        timeout counts from the first call to "check". Once a limit has been reached, the result has the status
+     *        UNKNOWN. Must be called before "check".
+     */
+    void setResourceLimits(const ResourceLimits &limits) { resourceLimits = limits; }
+
+    /**
+     * @brief Sets a directory in which the results are cached across runs (by default, none is used). A formula found
+     *        in the cache is answered without a search, or the search resumes after the largest bound known to have no
+     *        model. Must be called before "check".
+     */
+    void setResultCacheDirectory(const std::string &directory) { resultCacheDirectory = directory; }
+
+    /**
+     * @brief Sets a function that is called after every bound that has been checked, with the bound and the result
+     */
+    void setProgressCallback(const std::function<void(int,IncrementalSATSolver::Result)> &callback) { progressCallback = callback; }
+
+    /**
+     * @brief Sets a function that is called after every bound that has been checked, with detailed statistics
+     */
+    void setStatisticsCallback(const std::function<void(const BoundStatistics &)> &callback) { statisticsCallback = callback; }
+
+    /**
+     * @brief Aborts a running "check" (from another thread). The result then has the status CANCELLED.
+     */
+    void cancel() { cancelled = true; }
+    bool isCancelled() const { return cancelled; }
+};
+
+#endif
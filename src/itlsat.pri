@@ -0,0 +1,36 @@
+# Everything except for the command line tool - shared by "Project.pro" and "libitlsat.pro"
+DEPENDPATH += .
+INCLUDEPATH += ../picosat-957
+
+QMAKE_CXXFLAGS += -Wall -std=c++11 -pthread
+LIBS += -ldl -lz -pthread
+
+# Input
+FLEXSOURCES = lexer.flex
+BISONSOURCES = parser.y
+ 
+flex.commands = flex ${QMAKE_FILE_IN} && mv lex.yy.c lex.yy.cc
+flex.input = FLEXSOURCES
+flex.output = lex.yy.cc
+flex.variable_out = SOURCES
+flex.depends = y.tab.h
+flex.name = flex
+QMAKE_EXTRA_COMPILERS += flex
+ 
+bison.commands = bison -d -t -o y.tab.c ${QMAKE_FILE_IN} && mv y.tab.c y.tab.cpp
+bison.input = BISONSOURCES
+bison.output = y.tab.cpp
+bison.variable_out = SOURCES
+bison.name = bison
+QMAKE_EXTRA_COMPILERS += bison
+ 
+bisonheader.commands = @true
+bisonheader.input = BISONSOURCES
+bisonheader.output = y.tab.h
+bisonheader.variable_out = HEADERS
+bisonheader.name = bison header
+bisonheader.depends = y.tab.cpp
+QMAKE_EXTRA_COMPILERS += bisonheader
+
+HEADERS += y.tab.h itlsat.hpp formulaFactory.hpp parser.hpp symbolTable.hpp satChecker.hpp portfolioChecker.hpp batchChecker.hpp server.hpp threadPool.hpp satVariableTable.hpp satSolver.hpp ../picosat-957/picosat.h abstractSatisfiabilityChecker.hpp symmetryDetector.hpp certificateValidator.hpp icnfWriter.hpp resultCache.hpp
+SOURCES += itlsat.cpp satChecker.cpp portfolioChecker.cpp batchChecker.cpp server.cpp threadPool.cpp satSolver.cpp formulaFactory.cpp ../picosat-957/picosat.c abstractSatisfiabilityChecker.cpp symmetryDetector.cpp certificateValidator.cpp icnfWriter.cpp resultCache.cpp
@@ -0,0 +1,5 @@
+TEMPLATE = lib
+TARGET = itlsat
+CONFIG = staticlib release
+
+include(itlsat.pri)
@@ -1,25 +1,31 @@
 #include <iostream>
 #include "formulaFactory.hpp"
-#include "y.tab.h"
+#include "parser.hpp"
 #include "satChecker.hpp"
+#include "portfolioChecker.hpp"
+#include "batchChecker.hpp"
+#include "server.hpp"
 #include <sstream>
-
-// The singleton instance of our formula factories
-FormulaFactory formulaFactory;
-
-// Produced by the parser run.
-extern int mainFormulaNr;
-
-// The following declaration is not produced by every version of bison
-int yyparse (void);
-
-int yyerror (const char *s) {                                                     
-    std::cerr << "Parser error: " << s << std::endl;
-    return 0;
-}
+#include <fstream>
+#include <thread>
 
 int main(int argv, const char **args) {
     int maxBound = -1;
+    bool useActivationLiterals = false;
+    bool useSymmetryBreaking = false;
+    bool validateCertificates = false;
+    bool printStatistics = false;
+    std::string statisticsFile = ""; // Empty: Standard output
+    bool simplifyFormula = true;
+    bool nativeDerivedOperators = true;
+    std::string satSolverBackend = "picosat";
+    int nofThreads = 0; // 0: Not given
+    std::string batchFiles = "";
+    std::string serverSocket = "";
+    std::string icnfFile = "";
+    std::string resultCacheDirectory = "";
+    BoundStrategy boundStrategy = BS_LINEAR;
+    ResourceLimits resourceLimits;
     for (int i=1;i<argv;i++) {
         std::string current = args[i];
         if (current=="--max-bound") {
@@ -35,23 +41,217 @@ int main(int argv, const char **args) {
                 }
                 i++;
             }
+        } else if (current=="--activation-literals") {
+            useActivationLiterals = true;
+        } else if (current=="--symmetry-breaking") {
+            useSymmetryBreaking = true;
+        } else if (current.substr(0,8)=="--stats=") {
+            std::string format = current.substr(8);
+            if (format.substr(0,5)=="json:") {
+                statisticsFile = format.substr(5);
+                if (statisticsFile=="") {
+                    std::cerr << "Error: No file name given after parameter --stats=json:\n";
+                    return 1;
+                }
+                format = "json";
+            }
+            if (format!="json") {
+                std::cerr << "Error: Unknown statistics format '" << format << "'. Supported are 'json' and 'json:<file>'.\n";
+                return 1;
+            }
+            printStatistics = true;
+        } else if (current=="--validate") {
+            validateCertificates = true;
+        } else if (current=="--no-simplify") {
+            simplifyFormula = false;
+        } else if (current=="--derived-operators") {
+            if (i==argv-1) {
+                std::cerr << "Error: No encoding given after parameter --derived-operators\n";
+                return 1;
+            }
+            std::string encoding = args[++i];
+            if (encoding=="native") {
+                nativeDerivedOperators = true;
+            } else if (encoding=="desugar") {
+                nativeDerivedOperators = false;
+            } else {
+                std::cerr << "Error: Unknown encoding of the derived operators '" << encoding << "'. Supported are 'native' and 'desugar'.\n";
+                return 1;
+            }
+        } else if (current=="--threads") {
+            if (i==argv-1) {
+                std::cerr << "Error: No number after parameter --threads\n";
+                return 1;
+            } else {
+                std::istringstream is(args[i+1]);
+                is >> nofThreads;
+                if (is.fail() || (nofThreads<1)) {
+                    std::cerr << "Error: No valid number of threads given after --threads\n";
+                    return 1;
+                }
+                i++;
+            }
+        } else if ((current=="--timeout") || (current=="--conflict-budget") || (current=="--memory-limit")) {
+            if (i==argv-1) {
+                std::cerr << "Error: No number after parameter " << current << "\n";
+                return 1;
+            }
+            std::istringstream is(args[++i]);
+            double value;
+            is >> value;
+            if (is.fail() || (value<0) || ((value==0) && (current!="--conflict-budget"))) {
+                std::cerr << "Error: No valid number given after " << current << "\n";
+                return 1;
+            }
+            if (current=="--timeout") {
+                resourceLimits.timeout = value;
+            } else if (current=="--conflict-budget") {
+                resourceLimits.conflictBudget = (long long)value;
+            } else {
+                resourceLimits.memoryLimit = (long long)(value*1024*1024);
+            }
+        } else if (current=="--bound-strategy") {
+            if (i==argv-1) {
+                std::cerr << "Error: No strategy given after parameter --bound-strategy\n";
+                return 1;
+            }
+            std::string strategy = args[++i];
+            if (strategy=="linear") {
+                boundStrategy = BS_LINEAR;
+            } else if (strategy=="galloping") {
+                boundStrategy = BS_GALLOPING;
+            } else if (strategy=="direct") {
+                boundStrategy = BS_DIRECT;
+            } else {
+                std::cerr << "Error: Unknown bound strategy '" << strategy << "'. Supported are 'linear', 'galloping', and 'direct'.\n";
+                return 1;
+            }
+        } else if (current=="--batch") {
+            if (i==argv-1) {
+                std::cerr << "Error: No directory or file list given after parameter --batch\n";
+                return 1;
+            }
+            batchFiles = args[++i];
+        } else if (current=="--server") {
+            if (i==argv-1) {
+                std::cerr << "Error: No socket path (or '-' for the standard input) given after parameter --server\n";
+                return 1;
+            }
+            serverSocket = args[++i];
+        } else if (current=="--emit-icnf") {
+            if (i==argv-1) {
+                std::cerr << "Error: No file name given after parameter --emit-icnf\n";
+                return 1;
+            }
+            icnfFile = args[++i];
+        } else if (current=="--cache-dir") {
+            if (i==argv-1) {
+                std::cerr << "Error: No directory given after parameter --cache-dir\n";
+                return 1;
+            }
+            resultCacheDirectory = args[++i];
+        } else if (current=="--sat-solver") {
+            if (i==argv-1) {
+                std::cerr << "Error: No solver given after parameter --sat-solver\n";
+                return 1;
+            }
+            satSolverBackend = args[++i];
         } else {
             std::cerr << "Error: Did not understand option '" << current << "'\n";
             return 1;
         }
     }
+    if ((nofThreads>1 || batchFiles!="" || serverSocket!="") && (boundStrategy!=BS_LINEAR)) {
+        std::cerr << "Error: Multiple threads, the batch mode, and the server mode can only be used with the linear bound strategy\n";
+        return 1;
+    }
+    if ((batchFiles!="" || serverSocket!="") && printStatistics) {
+        std::cerr << "Error: Statistics can only be printed when checking a single formula\n";
+        return 1;
+    }
+    if ((icnfFile!="") && (nofThreads>1 || batchFiles!="" || serverSocket!="" || boundStrategy==BS_GALLOPING)) {
+        std::cerr << "Error: The SAT instance can only be written when checking a single formula with a single thread and the linear or direct bound strategy\n";
+        return 1;
+    }
+    if ((resultCacheDirectory!="") && ((nofThreads>1 && batchFiles=="" && serverSocket=="") || boundStrategy!=BS_LINEAR)) {
+        std::cerr << "Error: The result cache can only be used with the linear bound strategy and without a portfolio of threads\n";
+        return 1;
+    }
+    std::ofstream statisticsOutFile;
+    if (statisticsFile!="") {
+        statisticsOutFile.open(statisticsFile.c_str());
+        if (statisticsOutFile.fail()) {
+            std::cerr << "Error: Cannot write to the statistics file '" << statisticsFile << "'\n";
+            return 1;
+        }
+    }
+    std::ostream &statisticsOut = (statisticsFile!="")?statisticsOutFile:std::cout;
+    auto statisticsPrinter = [&statisticsOut](const BoundStatistics &statistics) {
+        statisticsOut << statistics.toJSON() << std::endl;
+    };
     try {
-        int returnValue = yyparse();
-        if (returnValue==0) {
-            //std::cout << "=========================[Parsed Formula]==========================\n";
-            //formulaFactory.printFormula(mainFormulaNr);
-            std::cout << "==================[Satisfiability Checking Result]=================\n";
-            SatisfiabilityChecker checker(mainFormulaNr);
-            checker.run(maxBound);
+        if (batchFiles!="") {
+            if (nofThreads==0) nofThreads = std::max(1U,std::thread::hardware_concurrency());
+            BatchChecker checker(batchFiles,maxBound,nofThreads,satSolverBackend);
+            checker.setUseActivationLiterals(useActivationLiterals);
+            checker.setUseSymmetryBreaking(useSymmetryBreaking);
+            checker.setSimplifyFormulas(simplifyFormula);
+            checker.setNativeDerivedOperators(nativeDerivedOperators);
+            checker.setValidateModels(validateCertificates);
+            checker.setResourceLimits(resourceLimits);
+            checker.setResultCacheDirectory(resultCacheDirectory);
+            checker.run();
             return 0;
         }
+        if (serverSocket!="") {
+            if (nofThreads==0) nofThreads = std::max(1U,std::thread::hardware_concurrency());
+            SatisfiabilityServer server(nofThreads,maxBound,satSolverBackend,useActivationLiterals);
+            server.setDefaultSimplifyFormula(simplifyFormula);
+            server.setDefaultNativeDerivedOperators(nativeDerivedOperators);
+            server.setDefaultUseSymmetryBreaking(useSymmetryBreaking);
+            server.setDefaultValidateModels(validateCertificates);
+            server.setDefaultResourceLimits(resourceLimits);
+            server.setResultCacheDirectory(resultCacheDirectory);
+            if (serverSocket=="-") {
+                server.serveStandardInput();
+            } else {
+                server.serveSocket(serverSocket);
+            }
+            return 0;
+        }
+
+        FormulaFactory formulaFactory;
+        int mainFormulaNr = parseFormula(formulaFactory,stdin);
+        //std::cout << "=========================[Parsed Formula]==========================\n";
+        //formulaFactory.printFormula(mainFormulaNr);
+        std::cout << "==================[Satisfiability Checking Result]=================\n";
+        int preparedFormulaNr = SatisfiabilityChecker::prepareFormula(formulaFactory,mainFormulaNr,true,simplifyFormula,nativeDerivedOperators);
+        if (nofThreads<=1) {
+            SatisfiabilityChecker checker(formulaFactory,preparedFormulaNr,satSolverBackend);
+            checker.setUseActivationLiterals(useActivationLiterals);
+            checker.setValidateCertificates(validateCertificates);
+            checker.setResourceLimits(resourceLimits);
+            if (icnfFile!="") checker.setEmitICNF(icnfFile);
+            if (resultCacheDirectory!="") checker.setResultCache(resultCacheDirectory);
+            if (printStatistics) checker.setStatisticsCallback(statisticsPrinter);
+            if (useSymmetryBreaking) {
+                checker.setUseSymmetryBreaking(true);
+                std::cout << "Symmetry generators found: " << checker.getNofSymmetryGenerators() << std::endl;
+            }
+            checker.run(maxBound,boundStrategy);
+        } else {
+            PortfolioSatisfiabilityChecker checker(formulaFactory,preparedFormulaNr,nofThreads,satSolverBackend);
+            checker.setUseActivationLiterals(useActivationLiterals);
+            checker.setUseSymmetryBreaking(useSymmetryBreaking);
+            checker.setValidateCertificates(validateCertificates);
+            checker.setResourceLimits(resourceLimits);
+            if (printStatistics) checker.setStatisticsCallback(statisticsPrinter);
+            checker.run(maxBound);
+        }
+        return 0;
     } catch (std::string error) {
         std::cerr << "Error: " << error << std::endl;
+        return 1;
     }
 }
 
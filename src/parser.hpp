@@ -0,0 +1,83 @@
+#ifndef __PARSER_HPP__
+#define __PARSER_HPP__
+
+#include <cstdio>
+#include <cstring>
+#include "formulaFactory.hpp"
+#include "symbolTable.hpp"
+
+// The state of the reentrant lexer, declared in the same way as in the code generated by flex
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
+
+/**
+ * @brief State of a parser run. It is passed to the parser actions and the lexer, so that neither of them has any
+ *        global state, and several formulas can be parsed concurrently.
+ */
+struct ParserContext {
+    FormulaFactory &factory;
+    int mainFormula;
+    std::string errorMessage;
+
+    // Identifiers read by the lexer, and what they have been resolved to so far (or 1 if they have not been resolved
+    // yet, which is neither an AP number nor a formula type of a temporal operator)
+    SymbolTable symbols;
+    std::vector<int> propositionOfSymbol;
+    std::vector<int> diamondTypeOfSymbol;
+    std::vector<int> boxTypeOfSymbol;
+
+    ParserContext(FormulaFactory &_factory) : factory(_factory), mainFormula(0) {}
+
+    int getProposition(int symbol) {
+        if (symbol>=(int)propositionOfSymbol.size()) propositionOfSymbol.resize(symbols.getNofSymbols(),1);
+        if (propositionOfSymbol[symbol]==1) propositionOfSymbol[symbol] = factory.getPropositionalFormula(symbols.getString(symbol));
+        return propositionOfSymbol[symbol];
+    }
+    FormulaType getDiamondOperatorType(int symbol) {
+        if (symbol>=(int)diamondTypeOfSymbol.size()) diamondTypeOfSymbol.resize(symbols.getNofSymbols(),-1);
+        if (diamondTypeOfSymbol[symbol]==-1) diamondTypeOfSymbol[symbol] = FormulaFactory::getDiamondOperatorType(symbols.getString(symbol));
+        return (FormulaType)diamondTypeOfSymbol[symbol];
+    }
+    FormulaType getBoxOperatorType(int symbol) {
+        if (symbol>=(int)boxTypeOfSymbol.size()) boxTypeOfSymbol.resize(symbols.getNofSymbols(),-1);
+        if (boxTypeOfSymbol[symbol]==-1) boxTypeOfSymbol[symbol] = FormulaFactory::getBoxOperatorType(symbols.getString(symbol));
+        return (FormulaType)boxTypeOfSymbol[symbol];
+    }
+};
+
+/**
+ * @brief The input of the lexer: a buffer in memory, which is handed to the lexer through its YY_INPUT macro
+ */
+struct ParserInput {
+    const char *data;
+    size_t size;
+    size_t position;
+    ParserContext *context;
+
+    size_t read(char *buffer, size_t maxSize) {
+        size_t length = std::min(maxSize,size-position);
+        memcpy(buffer,data+position,length);
+        position += length;
+        return length;
+    }
+};
+
+/**
+ * @brief Parses an ITL formula from a buffer in memory into the given formula factory
+ * @return the number of the parsed formula in the factory
+ */
+int parseFormula(FormulaFactory &factory, const char *data, size_t size);
+
+/**
+ * @brief Parses an ITL formula from a file, which is memory-mapped
+ */
+int parseFormulaFile(FormulaFactory &factory, const std::string &filename);
+
+/**
+ * @brief Parses an ITL formula from a stream that cannot be memory-mapped, such as the standard input
+ */
+int parseFormula(FormulaFactory &factory, FILE *input);
+
+#endif
@@ -1,20 +1,31 @@
+%code requires {
+#include "parser.hpp"
+}
+
 %{
 #include <stdio.h>
 #include "formulaFactory.hpp"
+#include "parser.hpp"
 #include <boost/smart_ptr.hpp>
-int yylex(void);
-void yyerror(const char *);
-int mainFormulaNr;
 %}
 
+%define api.pure full
+%parse-param { ParserContext *context } { yyscan_t scanner }
+%lex-param { yyscan_t scanner }
+
 %union 
 {
-        std::string *string;
+        int symbol;
         int formulaTablePointer;
 }
 
+%code {
+int yylex(YYSTYPE *yylval, yyscan_t scanner);
+void yyerror(ParserContext *context, yyscan_t scanner, const char *);
+}
+
 // Symbols and precedence.
-%token <string> WORD
+%token <symbol> WORD
 %token ERROR
 %left OR MINUS
 %left AND
@@ -26,17 +37,92 @@ int mainFormulaNr;
 
 
 Expression:
-    Formula { mainFormulaNr = $1; }
+    Formula { context->mainFormula = $1; }
 
 Formula: 
-      Formula OR Formula { $$ = formulaFactory.getOr($1,$3); }
-    | Formula MINUS RANGLE Formula { $$ = formulaFactory.getOr(formulaFactory.getNot($1),$4); }
-    | Formula AND Formula { $$ = formulaFactory.getAnd($1,$3); }
+      Formula OR Formula { $$ = context->factory.getOr($1,$3); }
+    | Formula MINUS RANGLE Formula { $$ = context->factory.getOr(context->factory.getNot($1),$4); }
+    | Formula AND Formula { $$ = context->factory.getAnd($1,$3); }
     | LPAREN Formula RPAREN { $$ = $2; }
-    | NOT Formula { $$ = formulaFactory.getNot($2); }
-    | MINUS Formula { $$ = formulaFactory.getNot($2); }
-    | LANGLE WORD RANGLE Formula { $$ = formulaFactory.getDiamondTemporalFormula($2,$4); delete $2; }
-    | LSQUARED WORD RSQUARED Formula { $$ = formulaFactory.getBoxTemporalFormula($2,$4); delete $2; }
-    | WORD { $$ = formulaFactory.getPropositionalFormula($1); delete $1;}
+    | NOT Formula { $$ = context->factory.getNot($2); }
+    | MINUS Formula { $$ = context->factory.getNot($2); }
+    | LANGLE WORD RANGLE Formula { $$ = context->factory.getTemporalFormula(context->getDiamondOperatorType($2),$4); }
+    | LSQUARED WORD RSQUARED Formula { $$ = context->factory.getTemporalFormula(context->getBoxOperatorType($2),$4); }
+    | WORD { $$ = context->getProposition($1); }
     ;
+%%
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+int yylex_init_extra(ParserInput *input, yyscan_t *scanner);
+int yylex_destroy(yyscan_t scanner);
 
+void yyerror(ParserContext *context, yyscan_t, const char *s) {
+    context->errorMessage = s;
+}
+
+int parseFormula(FormulaFactory &factory, const char *data, size_t size) {
+    ParserContext context(factory);
+    ParserInput input;
+    input.data = data;
+    input.size = size;
+    input.position = 0;
+    input.context = &context;
+    yyscan_t scanner;
+    if (yylex_init_extra(&input,&scanner)!=0) {
+        throw std::string("Cannot initialize the lexer");
+    }
+    int parserResult;
+    try {
+        parserResult = yyparse(&context,scanner);
+    } catch (...) {
+        yylex_destroy(scanner);
+        throw;
+    }
+    yylex_destroy(scanner);
+    if (parserResult!=0) {
+        throw std::string("Parser error: ")+context.errorMessage;
+    }
+    return context.mainFormula;
+}
+
+int parseFormula(FormulaFactory &factory, FILE *input) {
+    std::vector<char> buffer;
+    char chunk[65536];
+    size_t nofBytes;
+    while ((nofBytes = fread(chunk,1,sizeof(chunk),input))>0) {
+        buffer.insert(buffer.end(),chunk,chunk+nofBytes);
+    }
+    if (ferror(input)) throw std::string("Cannot read the formula");
+    return parseFormula(factory,buffer.data(),buffer.size());
+}
+
+int parseFormulaFile(FormulaFactory &factory, const std::string &filename) {
+    int fd = open(filename.c_str(),O_RDONLY);
+    if (fd<0) throw std::string("Cannot open file '")+filename+"'";
+    struct stat fileStatus;
+    if (fstat(fd,&fileStatus)!=0) {
+        close(fd);
+        throw std::string("Cannot read file '")+filename+"'";
+    }
+    if (fileStatus.st_size==0) {
+        // Empty files cannot be mapped
+        close(fd);
+        return parseFormula(factory,"",0);
+    }
+    void *data = mmap(NULL,fileStatus.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+    close(fd);
+    if (data==MAP_FAILED) throw std::string("Cannot read file '")+filename+"'";
+    int result;
+    try {
+        result = parseFormula(factory,(const char*)data,fileStatus.st_size);
+    } catch (...) {
+        munmap(data,fileStatus.st_size);
+        throw;
+    }
+    munmap(data,fileStatus.st_size);
+    return result;
+}
@@ -0,0 +1,154 @@
+#include "portfolioChecker.hpp"
+#include <thread>
+#include <climits>
+#include <functional>
+#include <algorithm>
+
+PortfolioSatisfiabilityChecker::PortfolioSatisfiabilityChecker(const FormulaFactory &_factory, int mainFormula, int _nofThreads, const std::string &_satSolverBackend) : factory(_factory) {
+    mainFormulaNumber = mainFormula;
+    nofThreads = _nofThreads;
+    satSolverBackend = _satSolverBackend;
+    useActivationLiterals = false;
+    useSymmetryBreaking = false;
+    validateCertificates = false;
+    winner = -1;
+    resourceLimitReached = NULL;
+}
+
+void PortfolioSatisfiabilityChecker::worker(int workerNr, SatisfiabilityChecker &checker, int maxBound) {
+    try {
+        while (!aborted) {
+            int bound = nextBound++;
+            if ((maxBound!=-1) && (bound>maxBound)) return;
+            if (bound>=smallestSatisfiableBound) return;
+            if (bound>=smallestUnsatisfiableForLongerWordsBound) return;
+            currentBounds[workerNr] = bound;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                std::cerr << "Trying a word of length " << bound << std::endl;
+            }
+
+            IncrementalSATSolver::Result result = checker.checkBound(bound);
+            if (result==IncrementalSATSolver::SATISFIABLE) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (bound<smallestSatisfiableBound) {
+                    smallestSatisfiableBound = bound;
+                    winner = workerNr;
+                }
+                return;
+            } else if (result==IncrementalSATSolver::UNKNOWN) {
+                // Interrupted as some other worker found a model for a smaller bound, or a resource limit has been reached
+                if (checker.getResourceLimitReached()!=NULL) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (resourceLimitReached==NULL) resourceLimitReached = checker.getResourceLimitReached();
+                    aborted = true;
+                }
+                return;
+            } else {
+                std::lock_guard<std::mutex> lock(mutex);
+                unsatisfiableBounds.insert(bound);
+                if (checker.isUnsatisfiableForLongerWords()) {
+                    if (bound<smallestUnsatisfiableForLongerWordsBound) smallestUnsatisfiableForLongerWordsBound = bound;
+                    return;
+                }
+            }
+        }
+    } catch (std::string e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (error=="") error = e;
+        aborted = true;
+    }
+}
+
+void PortfolioSatisfiabilityChecker::run(int maxBound) {
+    if ((maxBound<1) && (maxBound!=-1)) {
+        throw std::string("Maximum bound must be at least 1.");
+    }
+    if (nofThreads<1) {
+        throw std::string("The number of threads must be at least 1.");
+    }
+
+    nextBound = 1;
+    smallestSatisfiableBound = INT_MAX;
+    smallestUnsatisfiableForLongerWordsBound = INT_MAX;
+    aborted = false;
+    winner = -1;
+    error = "";
+    unsatisfiableBounds.clear();
+    resourceLimitReached = NULL;
+    currentBounds.reset(new std::atomic<int>[nofThreads]);
+
+    // The checkers are built before starting the threads, so that errors in the formula are reported right away
+    std::vector<boost::shared_ptr<SatisfiabilityChecker> > checkers;
+    for (int i=0;i<nofThreads;i++) {
+        currentBounds[i] = 0;
+        boost::shared_ptr<SatisfiabilityChecker> checker(new SatisfiabilityChecker(factory,mainFormulaNumber,satSolverBackend));
+        checker->setUseActivationLiterals(useActivationLiterals);
+        checker->setUseSymmetryBreaking(useSymmetryBreaking);
+        checker->setValidateCertificates(validateCertificates);
+        if (statisticsCallback) {
+            checker->setStatisticsCallback([this](const BoundStatistics &statistics) {
+                std::lock_guard<std::mutex> lock(mutex);
+                statisticsCallback(statistics);
+            });
+        }
+        std::atomic<int> &currentBound = currentBounds[i];
+        checker->setTerminateCallback([this,&currentBound]() {
+            return aborted || (smallestSatisfiableBound<currentBound) || (smallestUnsatisfiableForLongerWordsBound<currentBound);
+        });
+        checker->setResourceLimits(resourceLimits);
+        checkers.push_back(checker);
+    }
+
+    // Beyond the completeness threshold, there is nothing to check
+    int completenessThreshold = checkers[0]->getCompletenessThreshold();
+    int lastBound = maxBound;
+    if ((completenessThreshold!=-1) && ((maxBound==-1) || (completenessThreshold<maxBound))) {
+        std::cerr << "Completeness threshold: " << completenessThreshold << std::endl;
+        lastBound = completenessThreshold;
+    }
+
+    std::vector<std::thread> threads;
+    for (int i=0;i<nofThreads;i++) {
+        threads.push_back(std::thread(&PortfolioSatisfiabilityChecker::worker,this,i,std::ref(*(checkers[i])),lastBound));
+    }
+    for (auto it = threads.begin();it!=threads.end();it++) {
+        it->join();
+    }
+
+    if (error!="") throw error;
+    if (resourceLimitReached!=NULL) {
+        // The result is only conclusive if all bounds below the model found (or the bound from which on there is no
+        // model) have been checked
+        int provenBound = 0;
+        while (unsatisfiableBounds.count(provenBound+1)>0) provenBound++;
+        int lastBoundNeeded = (winner==-1)?std::min(smallestUnsatisfiableForLongerWordsBound.load(),lastBound):checkers[winner]->getWordLengthBound()-1;
+        if (lastBoundNeeded==-1) lastBoundNeeded = INT_MAX;
+        if (provenBound<lastBoundNeeded) {
+            std::cerr << "Result: Unknown - the " << resourceLimitReached << " has been reached. ";
+            if (provenBound==0) {
+                std::cerr << "No word length has been checked completely." << std::endl;
+            } else {
+                std::cerr << "There is no model of length up to " << provenBound << "." << std::endl;
+            }
+            return;
+        }
+    }
+    if ((winner==-1) && (smallestUnsatisfiableForLongerWordsBound!=INT_MAX)) {
+        // Without a resource limit, the workers only stop early on bounds larger than this one
+        std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model shorter than " << smallestUnsatisfiableForLongerWordsBound << ", and the contradiction found for this length does not depend on the word length" << std::endl;
+        return;
+    }
+    if ((winner==-1) && (lastBound!=maxBound)) {
+        std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model of length up to " << completenessThreshold << ", and the formula would have one if it was satisfiable" << std::endl;
+        return;
+    }
+    if (winner==-1) {
+        std::cerr << "Result: Aborting due to reaching the maximum bound of " << maxBound << std::endl;
+        return;
+    }
+    SatisfiabilityChecker &checker = *(checkers[winner]);
+    std::cerr << "Result: The temporal logic formula is satisfiable for a word of length " << checker.getWordLengthBound() << std::endl;
+    std::cerr << "We needed " << checker.getNofVariables() << " SAT Variables and " << checker.getNofClauses() << " clauses\n";
+    checker.printSimplifiedSatisfiabilityCertificate();
+}
@@ -0,0 +1,64 @@
+#ifndef __PORTFOLIO_CHECKER_HPP__
+#define __PORTFOLIO_CHECKER_HPP__
+
+#include "satChecker.hpp"
+#include <atomic>
+#include <mutex>
+#include <set>
+
+/**
+ * @brief Checks several word lengths concurrently. Every worker thread has its own satisfiability checker (and thus its
+ *        own SAT solver instance) and repeatedly takes the smallest bound that no worker has taken so far. As the
+ *        checkers are incremental, a worker that skips some bounds simply extends its encoding by several rows at once.
+ *
+ *        Once a worker finds a model, all workers on larger bounds are interrupted. The search ends when all bounds below
+ *        the smallest satisfiable one have been found to be unsatisfiable, so the reported model length is minimal, just
+ *        as in the sequential "SatisfiabilityChecker::run". Likewise, once a worker finds that there is no model of its
+ *        bound or any larger one, the workers on larger bounds are interrupted, and the formula is unsatisfiable if
+ *        there is no model of a smaller length either.
+ *
+ *        Once a worker reaches a resource limit, all workers stop, and the largest bound up to which all bounds have
+ *        been found to be unsatisfiable is reported. The timeout and the memory limit are shared by all workers, while
+ *        every worker has a conflict budget of its own.
+ */
+class PortfolioSatisfiabilityChecker {
+private:
+    const FormulaFactory &factory;
+    int mainFormulaNumber;
+    int nofThreads;
+    std::string satSolverBackend;
+    bool useActivationLiterals;
+    bool useSymmetryBreaking;
+    bool validateCertificates;
+    ResourceLimits resourceLimits;
+    std::function<void(const BoundStatistics &)> statisticsCallback;
+
+    // State shared between the workers
+    std::atomic<int> nextBound;
+    std::atomic<int> smallestSatisfiableBound;
+    std::atomic<int> smallestUnsatisfiableForLongerWordsBound;
+    std::atomic<bool> aborted;
+    boost::scoped_array<std::atomic<int> > currentBounds; // The bound each worker is checking right now
+    std::mutex mutex; // Protects "winner", "error", "unsatisfiableBounds", "resourceLimitReached" and the log output
+    int winner;
+    std::string error;
+    std::set<int> unsatisfiableBounds;
+    const char *resourceLimitReached;
+
+    void worker(int workerNr, SatisfiabilityChecker &checker, int maxBound);
+
+public:
+    PortfolioSatisfiabilityChecker(const FormulaFactory &factory, int mainFormula, int nofThreads, const std::string &satSolverBackend = "picosat");
+    void setUseActivationLiterals(bool value) { useActivationLiterals = value; }
+    void setUseSymmetryBreaking(bool value) { useSymmetryBreaking = value; }
+    void setValidateCertificates(bool value) { validateCertificates = value; }
+    void setResourceLimits(const ResourceLimits &limits) { resourceLimits = limits; }
+
+    /**
+     * @brief Sets a function that receives the statistics of every bound checked. It is called by one thread at a time.
+     */
+    void setStatisticsCallback(const std::function<void(const BoundStatistics &)> &callback) { statisticsCallback = callback; }
+    void run(int maxBound);
+};
+
+#endif
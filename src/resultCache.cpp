@@ -0,0 +1,142 @@
+#include "resultCache.hpp"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define RESULT_CACHE_HEADER "itlsat result cache 2" // Version 1 could contain wrong results from the completeness threshold
+
+/**
+ * @brief Creates the cache directory if it does not exist yet
+ */
+ResultCache::ResultCache(const std::string &_directory) : directory(_directory) {
+    if ((mkdir(directory.c_str(),0777)!=0) && (errno!=EEXIST)) {
+        throw std::string("Cannot create the result cache directory '")+directory+"'.";
+    }
+    struct stat fileInfo;
+    if ((stat(directory.c_str(),&fileInfo)!=0) || !S_ISDIR(fileInfo.st_mode)) {
+        throw std::string("The result cache '")+directory+"' is not a directory.";
+    }
+}
+
+/**
+ * @brief Mixes a 64 bit value into a hash (the finalizer of SplitMix64)
+ */
+static uint64_t mixHash(uint64_t hash, uint64_t value) {
+    uint64_t z = hash+value+0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30))*0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27))*0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Computes a 128 bit hash of the formula bottom-up. Atomic propositions are hashed by their names, and the hashes
+ *        of the parameters of a subformula are sorted before they are combined, as the order of the parameters in the
+ *        formula factory depends on the numbers of the subformulas. Two seeds give two independent 64 bit hashes.
+ */
+std::string ResultCache::computeKey(const FormulaFactory &factory, int formula) {
+    typedef std::pair<uint64_t,uint64_t> Hash;
+    std::vector<Hash> apHashes(factory.getAPNrs().size());
+    for (auto it = factory.getAPNrs().begin();it!=factory.getAPNrs().end();it++) {
+        Hash hash(1,2);
+        for (auto it2 = it->first.begin();it2!=it->first.end();it2++) {
+            hash.first = mixHash(hash.first,(unsigned char)*it2);
+            hash.second = mixHash(hash.second^0x5bd1e995ULL,(unsigned char)*it2);
+        }
+        apHashes[-it->second-1] = hash;
+    }
+    std::vector<Hash> hashes(std::max(formula+1,0));
+    for (int subformula=0;subformula<=formula;subformula++) {
+        FormulaChildren children = factory.getChildren(subformula);
+        std::vector<Hash> childHashes;
+        for (auto it = children.begin();it!=children.end();it++) {
+            childHashes.push_back((*it<0)?apHashes[-*it-1]:hashes[*it]);
+        }
+        std::sort(childHashes.begin(),childHashes.end());
+        Hash hash(mixHash(3,factory.getFormulaType(subformula)),mixHash(4,factory.getFormulaType(subformula)));
+        for (auto it = childHashes.begin();it!=childHashes.end();it++) {
+            hash.first = mixHash(hash.first,it->first);
+            hash.second = mixHash(hash.second^0x5bd1e995ULL,it->second);
+        }
+        hashes[subformula] = hash;
+    }
+    Hash result = (formula<0)?apHashes[-formula-1]:hashes[formula];
+    std::ostringstream key;
+    key << std::hex << std::setfill('0') << std::setw(16) << result.first << std::setw(16) << result.second;
+    return key.str();
+}
+
+/**
+ * @brief Reads the entry of a formula. Returns false if there is none or it cannot be read.
+ */
+bool ResultCache::lookup(const std::string &key, CachedResult &result) const {
+    std::ifstream inFile(getFilename(key).c_str());
+    if (inFile.fail()) return false;
+    std::string line;
+    if (!std::getline(inFile,line) || (line!=RESULT_CACHE_HEADER)) return false;
+    CachedResult entry;
+    while (std::getline(inFile,line)) {
+        std::istringstream is(line);
+        std::string field;
+        is >> field;
+        if (field=="largest-unsat-bound") {
+            is >> entry.largestUnsatisfiableBound;
+        } else if (field=="unsat-all") {
+            is >> entry.unsatisfiableForAllLengths;
+        } else if (field=="model-length") {
+            is >> entry.modelLength;
+        } else if (field=="ap") {
+            std::string ap;
+            unsigned int nofIntervals = 0;
+            is >> ap >> nofIntervals;
+            std::vector<std::pair<int,int> > &intervals = entry.certificate[ap];
+            for (unsigned int i=0;(i<nofIntervals) && !is.fail();i++) {
+                std::pair<int,int> interval;
+                is >> interval.first >> interval.second;
+                intervals.push_back(interval);
+            }
+        } else {
+            return false;
+        }
+        if (is.fail()) return false;
+    }
+    result = entry;
+    return true;
+}
+
+/**
+ * @brief Writes the entry of a formula to a temporary file first, which then replaces the old entry
+ */
+void ResultCache::store(const std::string &key, const CachedResult &result) const {
+    static std::atomic<int> nofTemporaryFiles(0);
+    std::ostringstream temporaryFilename;
+    temporaryFilename << getFilename(key) << ".tmp" << getpid() << "_" << nofTemporaryFiles++;
+    {
+        std::ofstream outFile(temporaryFilename.str().c_str());
+        outFile << RESULT_CACHE_HEADER << "\n";
+        outFile << "largest-unsat-bound " << result.largestUnsatisfiableBound << "\n";
+        outFile << "unsat-all " << result.unsatisfiableForAllLengths << "\n";
+        outFile << "model-length " << result.modelLength << "\n";
+        for (auto it = result.certificate.begin();it!=result.certificate.end();it++) {
+            outFile << "ap " << it->first << " " << it->second.size();
+            for (auto it2 = it->second.begin();it2!=it->second.end();it2++) {
+                outFile << " " << it2->first << " " << it2->second;
+            }
+            outFile << "\n";
+        }
+        outFile.close();
+        if (outFile.fail()) {
+            unlink(temporaryFilename.str().c_str());
+            throw std::string("Cannot write to the result cache '")+directory+"'.";
+        }
+    }
+    if (rename(temporaryFilename.str().c_str(),getFilename(key).c_str())!=0) {
+        unlink(temporaryFilename.str().c_str());
+        throw std::string("Cannot write to the result cache '")+directory+"'.";
+    }
+}
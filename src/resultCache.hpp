@@ -0,0 +1,38 @@
+#ifndef __RESULT_CACHE_HPP__
+#define __RESULT_CACHE_HPP__
+
+#include "formulaFactory.hpp"
+#include "certificateValidator.hpp"
+#include <string>
+
+/**
+ * @brief What is known about a formula from earlier runs
+ */
+struct CachedResult {
+    int largestUnsatisfiableBound; // There is no model of length 1 to this one (0 if nothing is known)
+    bool unsatisfiableForAllLengths;
+    int modelLength; // Minimal model length, or -1 if no model is known
+    CertificateValidator::Certificate certificate; // The model, if there is one
+    CachedResult() : largestUnsatisfiableBound(0), unsatisfiableForAllLengths(false), modelLength(-1) {}
+};
+
+/**
+ * @brief Stores the results of satisfiability checks in a directory, so that checking the same formula again can be
+ *        answered without a search, or resume a search where an earlier one has stopped. There is one text file per
+ *        formula, named after a structural hash of the formula that does not depend on the numbers of the subformulas
+ *        in the formula factory or on the order of the parameters of conjunctions and disjunctions. The files are
+ *        replaced atomically, so several processes can share a cache directory.
+ */
+class ResultCache {
+private:
+    std::string directory;
+    std::string getFilename(const std::string &key) const { return directory+"/"+key+".result"; }
+
+public:
+    ResultCache(const std::string &directory);
+    static std::string computeKey(const FormulaFactory &factory, int formula);
+    bool lookup(const std::string &key, CachedResult &result) const;
+    void store(const std::string &key, const CachedResult &result) const;
+};
+
+#endif
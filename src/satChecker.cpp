@@ -1,23 +1,246 @@
 #include "satChecker.hpp"
 #include <cstdio>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <unistd.h>
 #include "boost/tuple/tuple_io.hpp"
 #include "abstractSatisfiabilityChecker.hpp"
+#include "icnfWriter.hpp"
 
 #define INCREMENTAL_SOLVING
-#define PICOSAT_ADD_0 { picosat_add(picosat,0); nofClausesSoFar++; }
-#define PICOSAT_ADD(x) { assert(x!=0); picosat_add(picosat,x); }
+#define SAT_ADD_0 { solver->add(0); nofClausesSoFar++; }
+#define SAT_ADD(x) { assert(x!=0); solver->add(x); }
 
-SatisfiabilityChecker::SatisfiabilityChecker(int formula) {
-    picosat = picosat_init();
-    nofPicosatVariablesUsedSoFar = 0;
+/**
+ * @brief Measures the time spent in consecutive phases and reports it to a phase timing callback and/or adds it to a
+ *        variable (the "accumulator") per phase. The clock is only read if there is a callback or an accumulator.
+ */
+class PhaseTimer {
+private:
+    const PhaseTimingCallback &callback;
+    const char *phase;
+    int bound;
+    double *accumulator;
+    std::chrono::steady_clock::time_point startTime;
+    void report() {
+        if (!callback && (accumulator==NULL)) return;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+        if (callback) callback(phase,bound,seconds);
+        if (accumulator!=NULL) *accumulator += seconds;
+    }
+    void start() {
+        if (callback || (accumulator!=NULL)) startTime = std::chrono::steady_clock::now();
+    }
+public:
+    PhaseTimer(const PhaseTimingCallback &_callback, const char *_phase, int _bound, double *_accumulator = NULL) : callback(_callback), phase(_phase), bound(_bound), accumulator(_accumulator) {
+        start();
+    }
+    ~PhaseTimer() { report(); }
+
+    /**
+     * @brief Ends the current phase and starts the next one
+     */
+    void switchTo(const char *nextPhase, double *nextAccumulator = NULL) {
+        report();
+        phase = nextPhase;
+        accumulator = nextAccumulator;
+        start();
+    }
+};
+
+BoundStatistics::BoundStatistics() : bound(0), result(IncrementalSATSolver::UNKNOWN), encodingTime(0), abstractionTime(0),
+    solvingTime(0), newVariables(0), newClauses(0), nofAssumptions(0), nofFailedAssumptions(-1),
+    unsatisfiableForLongerWords(false), formulaMemory(0), variableTableMemory(0),
+    abstractionMemory(0), solverMemory(-1), residentMemory(-1) {}
+
+/**
+ * @brief Writes the statistics as a single-line JSON object. Values that are not known are written as null.
+ */
+std::string BoundStatistics::toJSON() const {
+    auto optional = [](long long value) { return (value<0)?std::string("null"):std::to_string(value); };
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(6);
+    json << "{\"bound\":" << bound << ",\"result\":\"";
+    switch (result) {
+    case IncrementalSATSolver::SATISFIABLE: json << "sat"; break;
+    case IncrementalSATSolver::UNSATISFIABLE: json << "unsat"; break;
+    case IncrementalSATSolver::UNKNOWN: json << "unknown"; break;
+    }
+    json << "\",\"time\":{\"encoding\":" << encodingTime << ",\"abstraction\":" << abstractionTime << ",\"solving\":" << solvingTime << "}";
+    json << ",\"new_variables\":" << newVariables << ",\"new_clauses\":" << newClauses << ",\"assumptions\":" << nofAssumptions;
+    json << ",\"failed_assumptions\":" << optional(nofFailedAssumptions) << ",\"unsat_for_longer_words\":" << (unsatisfiableForLongerWords?"true":"false");
+    json << ",\"solver\":{\"decisions\":" << optional(solver.decisions) << ",\"conflicts\":" << optional(solver.conflicts) << ",\"propagations\":" << optional(solver.propagations) << "}";
+    json << ",\"memory\":{\"formulas\":" << formulaMemory << ",\"variable_tables\":" << variableTableMemory << ",\"abstraction\":" << abstractionMemory;
+    json << ",\"sat_solver\":" << optional(solverMemory) << ",\"process_resident\":" << optional(residentMemory) << "}}";
+    return json.str();
+}
+
+/**
+ * @brief Returns the resident set size of the process in bytes, or -1 if it cannot be determined (only supported on Linux)
+ */
+static long long getResidentMemory() {
+    std::ifstream statm("/proc/self/statm");
+    long long totalPages = 0;
+    long long residentPages = 0;
+    if (!(statm >> totalPages >> residentPages)) return -1;
+    return residentPages*sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief Creates a checker for a formula that has been prepared by "prepareFormula". Several checkers can share the
+ *        same formula factory, as they do not modify it.
+ */
+SatisfiabilityChecker::SatisfiabilityChecker(const FormulaFactory &_factory, int formula, const std::string &_satSolverBackend) : factory(_factory) {
+    satSolverBackend = _satSolverBackend;
+    solver.reset(IncrementalSATSolver::create(satSolverBackend));
+    nofSATVariablesUsedSoFar = 0;
     wordLengthBoundSoFar = -1;
     mainFormulaNumber = formula;
     nofVariablesSoFar = 0;
     nofClausesSoFar = 0;
+    useActivationLiterals = false;
+    activationLiteral = 0;
+    validateCertificates = false;
+    resourceLimitReached = NULL;
+    unsatisfiableForLongerWords = false;
+    compileEncodingProgram();
+    completenessThreshold = computeCompletenessThreshold();
+    icnfWriter = NULL;
+    modelFromResultCache = false;
 }
 
 SatisfiabilityChecker::~SatisfiabilityChecker() {
-    picosat_reset(picosat);
+}
+
+/**
+ * @brief Returns the SAT variable for a subformula (or AP) on an interval, and allocates it if there is none yet
+ */
+int SatisfiabilityChecker::allocateVariable(int subformula, int from, int to) {
+    int &var = variables(subformula,from,to);
+    if (var==0) {
+        var = ++nofSATVariablesUsedSoFar;
+        nofVariablesSoFar++;
+        if ((icnfWriter!=NULL) && (subformula<0)) icnfWriter->writeVariableMapping(var,apNames[-subformula-1],from,to);
+    }
+    return var;
+}
+
+/**
+ * @brief Uses the result cache in the given directory for the linear searches (by "run" and "searchMinimalModel"). As
+ *        a cache entry could belong to another formula with the same hash, cached models are only used if the
+ *        "CertificateValidator" confirms them.
+ */
+void SatisfiabilityChecker::setResultCache(const std::string &directory) {
+    if (wordLengthBoundSoFar!=-1) throw std::string("The result cache must be set before the first bound is checked.");
+    resultCache.reset(new ResultCache(directory));
+    resultCacheKey = ResultCache::computeKey(factory,mainFormulaNumber);
+    if (!resultCache->lookup(resultCacheKey,cachedResult)) {
+        cachedResult = CachedResult();
+    } else if (cachedResult.modelLength!=-1) {
+        bool valid = false;
+        try {
+            valid = CertificateValidator::validate(factory,mainFormulaNumber,cachedResult.modelLength,cachedResult.certificate);
+        } catch (std::string) {
+            // The certificate does not fit the formula
+        }
+        if (!valid) cachedResult = CachedResult();
+    }
+}
+
+/**
+ * @brief Records the outcome of a linear search in the result cache (if there is one), where the bound is the one of a
+ *        "BoundSearchResult", i.e., the model length or the largest bound without a model
+ */
+void SatisfiabilityChecker::updateResultCache(BoundSearchResult::Status status, int bound) {
+    if (!resultCache || modelFromResultCache) return;
+    CachedResult updated = cachedResult;
+    if (status==BoundSearchResult::SATISFIABLE) {
+        updated.modelLength = bound;
+        updated.certificate = getModel();
+        updated.largestUnsatisfiableBound = bound-1;
+    } else {
+        if (status==BoundSearchResult::UNSATISFIABLE) updated.unsatisfiableForAllLengths = true;
+        updated.largestUnsatisfiableBound = std::max(updated.largestUnsatisfiableBound,bound);
+    }
+    if ((updated.modelLength==cachedResult.modelLength) && (updated.unsatisfiableForAllLengths==cachedResult.unsatisfiableForAllLengths) && (updated.largestUnsatisfiableBound==cachedResult.largestUnsatisfiableBound)) return;
+    cachedResult = updated;
+    resultCache->store(resultCacheKey,cachedResult);
+}
+
+/**
+ * @brief Streams the clauses and the assumptions of all bounds to the given file in the iCNF format, see "ICNFWriter".
+ *        Must be called before the first bound is checked.
+ */
+void SatisfiabilityChecker::setEmitICNF(const std::string &filename) {
+    if (wordLengthBoundSoFar!=-1) throw std::string("The iCNF output must be enabled before the first bound is checked.");
+    if (icnfWriter!=NULL) throw std::string("The iCNF output has already been enabled.");
+    icnfWriter = new ICNFWriter(*solver,filename);
+    unwrappedSolver.swap(solver);
+    solver.reset(icnfWriter);
+    apNames.resize(factory.getAPNrs().size());
+    for (auto it = factory.getAPNrs().begin();it!=factory.getAPNrs().end();it++) {
+        apNames[-it->second-1] = it->first;
+    }
+}
+
+/**
+ * @brief Enables the detection of symmetries of the formula and the symmetry breaking clauses. Must be called before
+ *        the first bound is checked.
+ */
+void SatisfiabilityChecker::setUseSymmetryBreaking(bool value) {
+    if (wordLengthBoundSoFar!=-1) throw std::string("Symmetry breaking must be enabled before the first bound is checked.");
+    if (!value) {
+        symmetries.reset();
+    } else if (!symmetries) {
+        symmetries.reset(new SymmetryDetector(factory,mainFormulaNumber));
+    }
+}
+
+void SatisfiabilityChecker::setTerminateCallback(const std::function<bool()> &callback) {
+    terminateCallback = callback;
+    installTerminateCallback();
+}
+
+void SatisfiabilityChecker::setResourceLimits(const ResourceLimits &limits) {
+    resourceLimits = limits;
+    if (limits.timeout>=0) {
+        deadline = std::chrono::steady_clock::now()+std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(limits.timeout));
+    }
+    if ((limits.conflictBudget>=0) && !solver->setEffortLimit(limits.conflictBudget)) {
+        throw std::string("The SAT solver '")+solver->getName()+"' does not support a conflict budget.";
+    }
+    installTerminateCallback();
+}
+
+/**
+ * @brief Lets the SAT solver poll the terminate callback and the resource limits (if there are any). As reading the
+ *        memory usage is comparably expensive, the resource limits are checked at most once per millisecond.
+ */
+void SatisfiabilityChecker::installTerminateCallback() {
+    if (!terminateCallback && (resourceLimits.timeout<0) && (resourceLimits.memoryLimit<0)) return;
+    solver->setTerminateCallback([this]() {
+        if (terminateCallback && terminateCallback()) return true;
+        if ((resourceLimits.timeout<0) && (resourceLimits.memoryLimit<0)) return false;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now<nextResourceCheck) return false;
+        nextResourceCheck = now+std::chrono::milliseconds(1);
+        return checkResourceLimits();
+    });
+}
+
+/**
+ * @brief Checks if the time or memory limit has been reached (or some limit has been reached before)
+ */
+bool SatisfiabilityChecker::checkResourceLimits() {
+    if (resourceLimitReached!=NULL) return true;
+    if ((resourceLimits.timeout>=0) && (std::chrono::steady_clock::now()>=deadline)) {
+        resourceLimitReached = "timeout";
+    } else if ((resourceLimits.memoryLimit>=0) && (getResidentMemory()>resourceLimits.memoryLimit)) {
+        resourceLimitReached = "memory limit";
+    }
+    return resourceLimitReached!=NULL;
 }
 
 /**
@@ -28,296 +251,543 @@ SatisfiabilityChecker::~SatisfiabilityChecker() {
  *        normal form, i.e., all negations are pushed inwards as much as possible, such that setting variables to FALSE that correspond
  *        to the valuation of variables that touch the boundaries of the word (+1) can always be set to FALSE.
  *
- *        The procedure assumes that "formulaNrs" of the formulaFactory is stripped of all sub-formulas that are not used by the main
+ *        The procedure assumes that "formulaNrs" of the formula factory is stripped of all sub-formulas that are not used by the main
  *        formula.
  * @param newLength The new length of the interval.
  */
 void SatisfiabilityChecker::extendWordLengthBound(int newLength) {
 
-    // Allocate new AP variables
-    const std::map<std::string,int> &apNrs = formulaFactory.getAPNrs();
-    for (auto it = apNrs.begin();it!=apNrs.end();it++) {
-        for (int i=0;i<newLength+1;i++) {
-            for (int j=i;j<newLength+1;j++) {
-                if ((i>wordLengthBoundSoFar) || (j>wordLengthBoundSoFar)) {
-                    satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)] = ++nofPicosatVariablesUsedSoFar;
-                    //std::cerr << "Allocated SAT Variable: " << boost::make_tuple(it->second,i,j) << " " << nofPicosatVariablesUsedSoFar << std::endl;
-                    nofVariablesSoFar++;
-                }
-            }
-        }
-    }
-
-    // Allocate new Formula variables
-    auto formulaNrs = formulaFactory.getFormulaNrs();
-    for (auto it = formulaNrs.begin();it!=formulaNrs.end();it++) {
-        for (int i=0;i<newLength+1;i++) {
-            for (int j=i;j<newLength+1;j++) {
-                if ((i>wordLengthBoundSoFar) || (j>wordLengthBoundSoFar)) {
-                    satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)] = ++nofPicosatVariablesUsedSoFar;
-                    nofVariablesSoFar++;
-                    //std::cerr << "Allocated SAT Variable for formula: " << boost::make_tuple(it->second,i,j) << " " << nofPicosatVariablesUsedSoFar << std::endl;
-                }
-            }
-        }
+    PhaseTimer timer(phaseTimingCallback,"encoding",newLength,&boundStatistics.encodingTime);
+    if (wordLengthBoundSoFar==-1) {
+        variables.init(factory.getAPNrs().size(),factory.getNofFormulas());
+        encodedCells.init(factory.getAPNrs().size(),factory.getNofFormulas());
+        comparedAPVariables.init(factory.getAPNrs().size(),0);
     }
+    variables.extend(newLength);
+    encodedCells.extend(newLength);
+    comparedAPVariables.extend(newLength);
 
     // Re-init
 #ifndef INCREMENTAL_SOLVING
-    picosat_reset(picosat);
-    picosat = picosat_init();
+    solver.reset(IncrementalSATSolver::create(satSolverBackend));
+    if (terminateCallback) solver->setTerminateCallback(terminateCallback);
+    encodedCells = SatVariableTable();
+    encodedCells.init(factory.getAPNrs().size(),factory.getNofFormulas());
+    encodedCells.extend(newLength);
+    symmetryBreakingChains.clear();
+    comparedAPVariables = SatVariableTable();
+    comparedAPVariables.init(factory.getAPNrs().size(),0);
+    comparedAPVariables.extend(newLength);
 #endif
 
-    // Add new formulas for the temporal operators
-    for (int i=0;i<newLength;i++) {
-        for (int j=i;j<newLength;j++) {
-#ifdef INCREMENTAL_SOLVING
-            if ((i>=wordLengthBoundSoFar) || (j>=wordLengthBoundSoFar))
-#endif
-            {
-                auto formulaNrs = formulaFactory.getFormulaNrs();
-                for (auto it = formulaNrs.begin();it!=formulaNrs.end();it++) {
-                    switch (it->first.get<0>()) {
-                    case TF_AND:
-                        for (auto it2 = it->first.get<1>().begin();it2!=it->first.get<1>().end();it2++) {
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(*it2,i,j)])
-                            PICOSAT_ADD_0
-                        }
-                        break;
-                    case TF_OR:
-                        PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                        for (auto it2 = it->first.get<1>().begin();it2!=it->first.get<1>().end();it2++) {
-                            //std::cerr << "U: " << i << "," << j << ", Pointer" << *it2 << std::endl;
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(*it2,i,j)]);
-                        }
-                        PICOSAT_ADD_0
-                        break;
-                    case TF_NOT:
-                        {
-                            int negatedLiteral = formulaFactory.getSingleParameterOfTemporalSubformula(it->second);
-                            if (negatedLiteral>0) {
-                                throw std::string("TF_NOT may only be applied to atomic propositions!");
-                            } else {
-                                PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                                PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(negatedLiteral,i,j)]);
-                                PICOSAT_ADD_0;
-                                // Speed up solving: Add a (redundant) clause for the converse direction
-                                PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                                PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(negatedLiteral,i,j)]);
-                                PICOSAT_ADD_0;
-                            }
-                        }
-                        break;
-                    case TF_DIAMOND_A:
-                        {
-                            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_DIAMOND_B_BAR,it->first.get<1>()));
-                            assert(it2!=formulaFactory.getFormulaNrs().end());
-                            int relevantBBarSubformula = it2->second;
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(relevantBBarSubformula,j,j)]);
-                            PICOSAT_ADD_0;
-                        }
-                        break;
-                    case TF_DIAMOND_B:
-                        PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                        if (j>i) {
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i,j-1)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j-1)]);
-                        }
-                        PICOSAT_ADD_0;
-                        break;
-                    case TF_DIAMOND_E:
-                        PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                        if (j>i) {
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i+1,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(it->second,i+1,j)]);
-                        }
-                        PICOSAT_ADD_0;
-                        break;
-                    case TF_DIAMOND_A_BAR:
-                        {
-                            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_DIAMOND_E_BAR,it->first.get<1>()));
-                            assert(it2!=formulaFactory.getFormulaNrs().end());
-                            int relevantBSubformula = it2->second;
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(relevantBSubformula,i,i)]);
-                            PICOSAT_ADD_0;
-                            break;
-                        }
-                    case TF_DIAMOND_E_BAR:
-                        {
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            if (i>0) {
-                                PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i-1,j)]);
-                                PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i-1,j)]);
-                            }
-                            PICOSAT_ADD_0;
-                            break;
-                        }
-                    case TF_DIAMOND_B_BAR:
-                        PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                        PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j+1)]);
-                        PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i,j+1)]);
-                        PICOSAT_ADD_0;
-                        break;
-                    case TF_BOX_A:
-                        {
-                            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_BOX_B_BAR,it->first.get<1>()));
-                            assert(it2!=formulaFactory.getFormulaNrs().end());
-                            int relevantBBarSubformula = it2->second;
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping.at(boost::make_tuple(it->second,i,j)));
-                            PICOSAT_ADD(satInstanceSubformulaMapping.at(boost::make_tuple(relevantBBarSubformula,j,j)));
-                            PICOSAT_ADD_0;
-                        }
-                        break;
-                    case TF_BOX_B:
-                        if (i<j) {
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i,j-1)]);
-                            PICOSAT_ADD_0;
-
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j-1)]);
-                            PICOSAT_ADD_0;
-                        }
+    // The abstract satisfiability checker tells which intervals of which subformulas are reachable from the main
+    // formula on (0,0) for the new bound.
+    timer.switchTo("abstraction",&boundStatistics.abstractionTime);
+    if (!abstractor) abstractor.reset(new AbstractSatisfiabilityChecker(factory,mainFormulaNumber));
+    abstractor->extendWordLength(newLength);
+    timer.switchTo("encoding",&boundStatistics.encodingTime);
+
+    // Add the clauses for the temporal operators on all reachable intervals that have not been encoded so far. As the
+    // set of reachable intervals only grows with the bound, these are the reachable ones in the new row as well as
+    // the intervals in earlier rows that have become reachable now. The box operators that look at longer intervals
+    // (B', D', and L) have clauses that are implied by the value on (i,j-1), but refer to the interval (i,j). These
+    // clauses are added with the row of (i,j) if (i,j-1) is reachable, so that they never refer to the intervals
+    // touching the end of the word. SAT variables are only allocated for the intervals that the clauses refer to.
+    for (int j=0;j<newLength;j++) {
+        for (int i=0;i<=j;i++) {
+            for (auto it = encodingProgram.begin();it!=encodingProgram.end();it++) {
+                int &encoded = encodedCells(it->subformula,i,j);
+                bool encodeCurrent = ((encoded & 1)==0) && abstractor->isReachable(it->subformula,i,j);
+                bool encodePrevious = (j>i) && ((encoded & 2)==0) && ((it->type==TF_BOX_B_BAR) || (it->type==TF_BOX_D_BAR) || (it->type==TF_BOX_L))
+                        && abstractor->isReachable(it->subformula,i,j-1);
+                if (!encodeCurrent && !encodePrevious) continue;
+                int self = allocateVariable(it->subformula,i,j);
+
+                // Clauses implied by the value on (i,j-1)
+                if (encodePrevious) {
+                    encoded |= 2;
+                    int previous = allocateVariable(it->subformula,i,j-1);
+                    switch (it->type) {
+                    case TF_BOX_B_BAR:
+                        SAT_ADD(-1*previous);
+                        SAT_ADD(self);
+                        SAT_ADD_0;
+                        SAT_ADD(-1*previous);
+                        SAT_ADD(allocateVariable(it->child,i,j));
+                        SAT_ADD_0;
                         break;
-                    case TF_BOX_E:
-                        if (i<j) {
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i+1,j)]);
-                            PICOSAT_ADD_0;
-
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(it->second,i+1,j)]);
-                            PICOSAT_ADD_0;
+                    case TF_BOX_D_BAR:
+                        SAT_ADD(-1*previous);
+                        SAT_ADD(self);
+                        SAT_ADD_0;
+                        if (i>0) {
+                            SAT_ADD(-1*previous);
+                            SAT_ADD(allocateVariable(it->child,i-1,j));
+                            SAT_ADD_0;
                         }
                         break;
-                    case TF_BOX_A_BAR:
-                        {
-                            auto it2 = formulaFactory.getFormulaNrs().find(boost::make_tuple(TF_BOX_E_BAR,it->first.get<1>()));
-                            assert(it2!=formulaFactory.getFormulaNrs().end());
-                            int relevantESubformula = it2->second;
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                            PICOSAT_ADD(satInstanceSubformulaMapping[boost::make_tuple(relevantESubformula,i,i)]);
-                            PICOSAT_ADD_0;
-                            break;
-                        }
-                    case TF_BOX_B_BAR:
-                        if (j>i) {
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping.at(boost::make_tuple(it->second,i,j-1)));
-                            PICOSAT_ADD(1*satInstanceSubformulaMapping.at(boost::make_tuple(it->second,i,j)));
-                            PICOSAT_ADD_0;
-                            PICOSAT_ADD(-1*satInstanceSubformulaMapping.at(boost::make_tuple(it->second,i,j-1)));
-                            PICOSAT_ADD(satInstanceSubformulaMapping.at(boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i,j)));
-                            PICOSAT_ADD_0;
-                        }
+                    case TF_BOX_L:
+                        SAT_ADD(-1*previous);
+                        SAT_ADD(self);
+                        SAT_ADD_0;
+                        SAT_ADD(-1*previous);
+                        SAT_ADD(allocateVariable(it->partner,j,j));
+                        SAT_ADD_0;
                         break;
-                    case TF_BOX_E_BAR:
-                        {
-                            if (i>0) {
-                                PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                                PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(formulaFactory.getSingleParameterOfTemporalSubformula(it->second),i-1,j)]);
-                                PICOSAT_ADD_0;
-                                PICOSAT_ADD(-1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)]);
-                                PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(it->second,i-1,j)]);
-                                PICOSAT_ADD_0;
-                            }
-                            break;
-                        }
                     default:
-                        std::cerr << "Code Found:" << it->first.get<0>() << std::endl;
-                        std::cerr << "Code Example: " << TF_BOX_E << std::endl;
-                        throw std::string("Error: Illegal subformula or unimplemented type during building the incremental SAT instance.");
+                        assert(false);
+                    }
+                }
+                if (!encodeCurrent) continue;
+                encoded |= 1;
+
+                // Clauses implied by the value on (i,j)
+                switch (it->type) {
+                case TF_AND:
+                    for (int k=it->childrenBegin;k<it->childrenEnd;k++) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(encodingChildren[k],i,j))
+                        SAT_ADD_0
+                    }
+                    break;
+                case TF_OR:
+                    SAT_ADD(-1*self);
+                    for (int k=it->childrenBegin;k<it->childrenEnd;k++) {
+                        SAT_ADD(allocateVariable(encodingChildren[k],i,j));
+                    }
+                    SAT_ADD_0
+                    break;
+                case TF_NOT:
+                    SAT_ADD(self);
+                    SAT_ADD(allocateVariable(it->child,i,j));
+                    SAT_ADD_0;
+                    // Speed up solving: Add a (redundant) clause for the converse direction
+                    SAT_ADD(-1*self);
+                    SAT_ADD(-1*allocateVariable(it->child,i,j));
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_A:
+                case TF_BOX_A:
+                    SAT_ADD(-1*self);
+                    SAT_ADD(allocateVariable(it->partner,j,j));
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_A_BAR:
+                case TF_BOX_A_BAR:
+                    SAT_ADD(-1*self);
+                    SAT_ADD(allocateVariable(it->partner,i,i));
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_B:
+                    SAT_ADD(-1*self);
+                    if (j>i) {
+                        SAT_ADD(allocateVariable(it->child,i,j-1));
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_E:
+                    SAT_ADD(-1*self);
+                    if (j>i) {
+                        SAT_ADD(allocateVariable(it->child,i+1,j));
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_E_BAR:
+                    SAT_ADD(-1*self);
+                    if (i>0) {
+                        SAT_ADD(allocateVariable(it->child,i-1,j));
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_B_BAR:
+                    SAT_ADD(-1*self);
+                    SAT_ADD(allocateVariable(it->subformula,i,j+1));
+                    SAT_ADD(allocateVariable(it->child,i,j+1));
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_B:
+                    if (i<j) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->child,i,j-1));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_BOX_E:
+                    if (i<j) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->child,i+1,j));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_BOX_B_BAR:
+                case TF_BOX_L:
+                    // Only clauses implied by the previous interval - see above
+                    break;
+                case TF_DIAMOND_D:
+                    // A strict sub-interval of (i,j) is (i+1,j-1) or a strict sub-interval of (i+1,j) or (i,j-1)
+                    SAT_ADD(-1*self);
+                    if (i+1<=j-1) SAT_ADD(allocateVariable(it->child,i+1,j-1));
+                    if (i<j) {
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_D:
+                    if (i+1<=j-1) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->child,i+1,j-1));
+                        SAT_ADD_0;
+                    }
+                    if (i<j) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_DIAMOND_D_BAR:
+                    // A strict super-interval of (i,j) is (i-1,j+1) or a strict super-interval of (i-1,j) or (i,j+1)
+                    SAT_ADD(-1*self);
+                    if (i>0) {
+                        SAT_ADD(allocateVariable(it->child,i-1,j+1));
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
+                    }
+                    SAT_ADD(allocateVariable(it->subformula,i,j+1));
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_D_BAR:
+                    // The parts referring to (i-1,j+1) and (i,j+1) are added with the next row - see above
+                    if (i>0) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_DIAMOND_L:
+                    // Some interval starts at j+1 (found by the <B'> partner), or the same holds for (i,j+1)
+                    SAT_ADD(-1*self);
+                    SAT_ADD(allocateVariable(it->partner,j+1,j+1));
+                    SAT_ADD(allocateVariable(it->subformula,i,j+1));
+                    SAT_ADD_0;
+                    break;
+                case TF_DIAMOND_L_BAR:
+                    // Some interval ends at i-1 (found by the <E'> partner), or the same holds for (i-1,j)
+                    SAT_ADD(-1*self);
+                    if (i>0) {
+                        SAT_ADD(allocateVariable(it->partner,i-1,i-1));
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
                     }
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_L_BAR:
+                    if (i>0) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->partner,i-1,i-1));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_DIAMOND_O:
+                    // Some interval that starts at i+1 ends after j (found by the <B'> partner), or the same holds for (i+1,j)
+                    SAT_ADD(-1*self);
+                    if (i<j) {
+                        SAT_ADD(allocateVariable(it->partner,i+1,j));
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_O:
+                    if (i<j) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->partner,i+1,j));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i+1,j));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_DIAMOND_O_BAR:
+                    // Some interval that ends at j-1 starts before i (found by the <E'> partner), or the same holds for (i,j-1)
+                    SAT_ADD(-1*self);
+                    if (i<j) {
+                        SAT_ADD(allocateVariable(it->partner,i,j-1));
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                    }
+                    SAT_ADD_0;
+                    break;
+                case TF_BOX_O_BAR:
+                    if (i<j) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->partner,i,j-1));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i,j-1));
+                        SAT_ADD_0;
+                    }
+                    break;
+                case TF_BOX_E_BAR:
+                    if (i>0) {
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->child,i-1,j));
+                        SAT_ADD_0;
+                        SAT_ADD(-1*self);
+                        SAT_ADD(allocateVariable(it->subformula,i-1,j));
+                        SAT_ADD_0;
+                    }
+                    break;
+                default:
+                    std::cerr << "Code Found:" << it->type << std::endl;
+                    std::cerr << "Code Example: " << TF_BOX_E << std::endl;
+                    throw std::string("Error: Illegal subformula or unimplemented type during building the incremental SAT instance.");
                 }
             }
         }
     }
 
+    if (symmetries) addSymmetryBreakingClauses(newLength);
+
     // Make sure that the new formula is satisfied (only to be added in the first iteration).
 #ifdef INCREMENTAL_SOLVING
     if (wordLengthBoundSoFar==-1)
 #endif
     {
-        PICOSAT_ADD(1*satInstanceSubformulaMapping[boost::make_tuple(mainFormulaNumber,0,0)]);
-        PICOSAT_ADD_0;
+        SAT_ADD(1*allocateVariable(mainFormulaNumber,0,0));
+        SAT_ADD_0;
     }
 
-    // picosat_print(picosat,stderr);
-
-    // Perform assumptions
-    for (auto it = satInstanceSubformulaMapping.begin();it!=satInstanceSubformulaMapping.end();it++) {
-        if (it->first.get<2>()==newLength) {
-            // All polarities are negative such that we never need to check the word boundaries for Diamond-based temporal operators
-            // with the exception of the BOX_B_BAR operator
-            if (formulaFactory.getFormulas()[it->first.get<0>()].get<0>()==TF_BOX_B_BAR) {
-            } else {
-                picosat_assume(picosat,-1*it->second);
+    // Build the frontier of the new bound: the variables for all intervals that touch the boundary of the word.
+    // All polarities are negative such that we never need to check the word boundaries for Diamond-based temporal operators
+    // with the exception of the BOX_B_BAR operator. Only intervals that the encoding refers to have variables.
+    boundaryFrontier.clear();
+    for (int slot=0;slot<variables.getNofSlots();slot++) {
+        int subformula = variables.getSubformula(slot);
+        if ((subformula<0) || (encodingProgram[subformula].type!=TF_BOX_B_BAR)) {
+            for (int i=0;i<=newLength;i++) {
+                int var = variables(subformula,i,newLength);
+                if (var!=0) boundaryFrontier.push_back(-1*var);
             }
         }
     }
 
-    // Assume main formula to be true
-    // mainFormulaNumber
     wordLengthBoundSoFar = newLength;
 
     // Use preprocessor to find trivial intervals
-    AbstractSatisfiabilityChecker abstractor(mainFormulaNumber,newLength);
-    auto storage = abstractor.getStorage();
-    for (auto it = formulaFactory.getFormulaNrs().begin();it!=formulaFactory.getFormulaNrs().end();it++) {
-        for (int i=0;i<newLength;i++) {
-            for (int j=i;j<newLength;j++) {
-                int satVariable = satInstanceSubformulaMapping[boost::make_tuple(it->second,i,j)];
-                auto it2 = storage.find(boost::make_tuple(it->second,i,j));
-                if (it2==storage.end()) {
-                    // Not reachable!
-                } else {
-                    if (it2->second==ThreeValueBool::FALSE) {
-                        //std::cerr << "NS" << satVariable << " ";
-                        picosat_assume(picosat,-1*satVariable);
-                    } else if (it2->second==ThreeValueBool::TRUE) {
-                        //std::cerr << "FT" << satVariable << " ";
-                        picosat_assume(picosat,1*satVariable);
-                    } else if (it2->second==ThreeValueBool::X) {
-                        // OK
-                    } else {
-                        throw std::string("Error: Unexpected result of the abstract satisfiability checker.");
-                    }
+    abstractionAssumptions.clear();
+    abstractor->forEachReachableNonXResult([this](int subformula, int from, int to, bool value) {
+        int satVariable = allocateVariable(subformula,from,to);
+        abstractionAssumptions.push_back(value?satVariable:-1*satVariable);
+    });
+
+    // With activation literals, the facts for this bound are not assumed one-by-one, but guarded by a fresh literal
+    // that is the only one to be assumed. The literal of the previous bound is retired by fixing it to FALSE, which
+    // allows the solver to drop the clauses guarded by it.
+    if (useActivationLiterals) {
+        if (activationLiteral!=0) {
+            SAT_ADD(-1*activationLiteral);
+            SAT_ADD_0;
+        }
+        activationLiteral = ++nofSATVariablesUsedSoFar;
+        nofVariablesSoFar++;
+        for (auto it = boundaryFrontier.begin();it!=boundaryFrontier.end();it++) {
+            SAT_ADD(-1*activationLiteral);
+            SAT_ADD(*it);
+            SAT_ADD_0;
+        }
+        for (auto it = abstractionAssumptions.begin();it!=abstractionAssumptions.end();it++) {
+            SAT_ADD(-1*activationLiteral);
+            SAT_ADD(*it);
+            SAT_ADD_0;
+        }
+    }
+}
+
+/**
+ * @brief Adds lexicographic-leader clauses for the AP variables that have been allocated since the last bound: for every
+ *        symmetry generator, the sequence of compared AP variables must be lexicographically at most the sequence
+ *        obtained by permuting the APs. As the clauses of the earlier bounds only constrain a prefix of the sequence,
+ *        every model can still be permuted into one that satisfies all of them, so no bound becomes unsatisfiable.
+ */
+void SatisfiabilityChecker::addSymmetryBreakingClauses(int newLength) {
+    const std::vector<int> &aps = symmetries->getAPs();
+    unsigned int nofGenerators = symmetries->getNofGenerators();
+    symmetryBreakingChains.resize(nofGenerators,0);
+    for (int j=0;j<newLength;j++) {
+        for (int i=0;i<=j;i++) {
+            for (int a=0;a<(int)aps.size();a++) {
+                int x = variables(aps[a],i,j);
+                int &compared = comparedAPVariables(aps[a],i,j);
+                if ((x==0) || compared) continue;
+                compared = 1;
+                for (unsigned int g=0;g<nofGenerators;g++) {
+                    const std::vector<int> &generator = symmetries->getGenerator(g);
+                    int b = generator[a];
+                    if (b==a) continue;
+                    // If a and b are swapped and the variable of b has been compared before, the variables of a and b
+                    // are already known to be equal when the chain gets here
+                    if ((generator[b]==a) && comparedAPVariables(aps[b],i,j)) continue;
+                    int y = allocateVariable(aps[b],i,j);
+                    int &equal = symmetryBreakingChains[g];
+
+                    // equal -> (x -> y)
+                    if (equal!=0) SAT_ADD(-1*equal);
+                    SAT_ADD(-1*x);
+                    SAT_ADD(y);
+                    SAT_ADD_0;
+
+                    // equal & (x <-> y) -> newEqual
+                    int newEqual = ++nofSATVariablesUsedSoFar;
+                    nofVariablesSoFar++;
+                    if (equal!=0) SAT_ADD(-1*equal);
+                    SAT_ADD(-1*x);
+                    SAT_ADD(-1*y);
+                    SAT_ADD(newEqual);
+                    SAT_ADD_0;
+                    if (equal!=0) SAT_ADD(-1*equal);
+                    SAT_ADD(x);
+                    SAT_ADD(y);
+                    SAT_ADD(newEqual);
+                    SAT_ADD_0;
+                    equal = newEqual;
                 }
             }
         }
     }
+}
 
+/**
+ * @brief Issues the assumptions for the current bound. These are only valid for the next call to the SAT solver.
+ */
+void SatisfiabilityChecker::assumeBoundFacts() {
+    if (useActivationLiterals) {
+        solver->assume(activationLiteral);
+        boundStatistics.nofAssumptions = 1;
+    } else {
+        boundStatistics.nofAssumptions = boundaryFrontier.size()+abstractionAssumptions.size();
+        for (auto it = boundaryFrontier.begin();it!=boundaryFrontier.end();it++) {
+            solver->assume(*it);
+        }
+        for (auto it = abstractionAssumptions.begin();it!=abstractionAssumptions.end();it++) {
+            solver->assume(*it);
+        }
+    }
+}
+
+IncrementalSATSolver::Result SatisfiabilityChecker::checkSatisfiabilityUnderBound() {
+    PhaseTimer timer(phaseTimingCallback,"solving",wordLengthBoundSoFar,&boundStatistics.solvingTime);
+    if (icnfWriter!=NULL) icnfWriter->writeComment("word length "+std::to_string(wordLengthBoundSoFar));
+    assumeBoundFacts();
+    IncrementalSATSolver::Result result = solver->solve();
+    if ((result==IncrementalSATSolver::UNKNOWN) && !(terminateCallback && terminateCallback()) && !checkResourceLimits()) {
+        if (resourceLimits.conflictBudget<0) {
+            throw std::string("Error: The SAT solver '")+solver->getName()+"' returned neither SATISFIABLE nor UNSATISFIABLE!";
+        }
+        resourceLimitReached = "conflict budget";
+    }
+    if (result==IncrementalSATSolver::UNSATISFIABLE) analyzeFailedAssumptions();
+    return result;
 }
 
-bool SatisfiabilityChecker::checkSatisfiabilityUnderBound() {
-    int picosatReturnValue = picosat_sat(picosat,-1);
-    if (picosatReturnValue==PICOSAT_SATISFIABLE) {
-        return true;
-    } else if (picosatReturnValue==PICOSAT_UNSATISFIABLE) {
-        return false;
+/**
+ * @brief Counts the assumptions of the current bound that the SAT solver has used for deriving the contradiction. If
+ *        there are none, the contradiction follows from the clauses alone, which are also part of the encoding of all
+ *        larger bounds.
+ */
+void SatisfiabilityChecker::analyzeFailedAssumptions() {
+    int nofFailed = 0;
+    if (useActivationLiterals) {
+        if (solver->isFailedAssumption(activationLiteral)) nofFailed++;
     } else {
-        throw std::string("Error: Picosat returned a value other than PICOSAT_SATISFIABLE and PICOSAT_UNSATISFIABLE!");
+        for (auto it = boundaryFrontier.begin();it!=boundaryFrontier.end();it++) {
+            if (solver->isFailedAssumption(*it)) nofFailed++;
+        }
+        for (auto it = abstractionAssumptions.begin();it!=abstractionAssumptions.end();it++) {
+            if (solver->isFailedAssumption(*it)) nofFailed++;
+        }
     }
+    boundStatistics.nofFailedAssumptions = nofFailed;
+    if (nofFailed==0) unsatisfiableForLongerWords = true;
+    boundStatistics.unsatisfiableForLongerWords = unsatisfiableForLongerWords;
+}
+
+/**
+ * @brief Extends the encoding to the given word length and checks if there is a model of exactly this length. The
+ *        bound may skip lengths, but must be larger than all bounds checked so far by this checker. The statistics of
+ *        the bound are passed to the statistics callback, if there is one.
+ * @return UNKNOWN if the check has been aborted by the terminate callback or a resource limit has been reached. In the
+ *         latter case, all further checks return UNKNOWN right away. Once a bound has been found to be unsatisfiable
+ *         independently of its assumptions, all further checks return UNSATISFIABLE right away.
+ */
+IncrementalSATSolver::Result SatisfiabilityChecker::checkBound(int bound) {
+    if (bound<=wordLengthBoundSoFar) {
+        throw std::string("Error: The bounds checked by a satisfiability checker must be increasing.");
+    }
+    boundStatistics = BoundStatistics();
+    int nofVariablesBefore = nofVariablesSoFar;
+    int nofClausesBefore = nofClausesSoFar;
+    IncrementalSATSolver::Statistics solverStatisticsBefore;
+    if (statisticsCallback) solverStatisticsBefore = solver->getStatistics();
+
+    IncrementalSATSolver::Result result = IncrementalSATSolver::UNKNOWN;
+    if (unsatisfiableForLongerWords) {
+        // No need to extend the encoding, as the solver would only find the same contradiction again
+        result = IncrementalSATSolver::UNSATISFIABLE;
+        boundStatistics.nofFailedAssumptions = 0;
+        boundStatistics.unsatisfiableForLongerWords = true;
+    } else if (!checkResourceLimits()) {
+        extendWordLengthBound(bound);
+        if (!checkResourceLimits()) result = checkSatisfiabilityUnderBound();
+    }
+
+    if (statisticsCallback) {
+        boundStatistics.bound = bound;
+        boundStatistics.result = result;
+        boundStatistics.newVariables = nofVariablesSoFar-nofVariablesBefore;
+        boundStatistics.newClauses = nofClausesSoFar-nofClausesBefore;
+        IncrementalSATSolver::Statistics solverStatistics = solver->getStatistics();
+        auto difference = [](long long after, long long before) { return ((after<0) || (before<0))?-1:after-before; };
+        boundStatistics.solver.decisions = difference(solverStatistics.decisions,solverStatisticsBefore.decisions);
+        boundStatistics.solver.conflicts = difference(solverStatistics.conflicts,solverStatisticsBefore.conflicts);
+        boundStatistics.solver.propagations = difference(solverStatistics.propagations,solverStatisticsBefore.propagations);
+        boundStatistics.formulaMemory = factory.getMemoryUsage();
+        boundStatistics.variableTableMemory = variables.getMemoryUsage()+encodedCells.getMemoryUsage()+comparedAPVariables.getMemoryUsage();
+        boundStatistics.abstractionMemory = abstractor?abstractor->getMemoryUsage():0;
+        boundStatistics.solverMemory = solverStatistics.memory;
+        boundStatistics.residentMemory = getResidentMemory();
+        statisticsCallback(boundStatistics);
+    }
+    return result;
 }
 
 void SatisfiabilityChecker::printSubformulaSATMapping() {
 
     std::cout << "=====================[Subformula to variable mapping]==============================\n";
-    for (auto it = formulaFactory.getFormulaNrs().begin();it!=formulaFactory.getFormulaNrs().end();it++) {
+    for (unsigned int subformula=0;subformula<factory.getNofFormulas();subformula++) {
         std::cout << "Formula:\n";
         std::cout.flush();
-        std::cout << "FID: " << it->second << std::endl;
-        formulaFactory.printFormula(it->second,2);
+        std::cout << "FID: " << subformula << std::endl;
+        factory.printFormula(subformula,2);
         std::cout << "[";
         for (int i=0;i<=wordLengthBoundSoFar;i++) {
             for (int j=0;j<=wordLengthBoundSoFar;j++) {
-                auto finder = satInstanceSubformulaMapping.find(boost::make_tuple(it->second,i,j));
-                if (finder == satInstanceSubformulaMapping.end()) {
+                int var = variables.get(subformula,i,j);
+                if (var==0) {
                     std::cout << "\t";
                 } else {
-                    std::cout << finder->second << "\t";
+                    std::cout << var << "\t";
                 }
             }
             if (i!=wordLengthBoundSoFar) std::cout << "\n"; else std::cout << "]\n";
@@ -329,16 +799,16 @@ void SatisfiabilityChecker::printSubformulaSATMapping() {
 void SatisfiabilityChecker::printAPtoSATMapping() {
     std::cout.flush();
     std::cout << "=====================[Atomic Proposition to variable mapping]==============================\n";
-    for (auto it = formulaFactory.getAPNrs().begin();it!=formulaFactory.getAPNrs().end();it++) {
+    for (auto it = factory.getAPNrs().begin();it!=factory.getAPNrs().end();it++) {
         std::cerr << "AP: " << it->first << std::endl;
         std::cout << "[";
         for (int i=0;i<=wordLengthBoundSoFar;i++) {
             for (int j=0;j<=wordLengthBoundSoFar;j++) {
-                auto finder = satInstanceSubformulaMapping.find(boost::make_tuple(it->second,i,j));
-                if (finder == satInstanceSubformulaMapping.end()) {
+                int var = variables.get(it->second,i,j);
+                if (var==0) {
                     std::cout << "\t";
                 } else {
-                    std::cout << finder->second << "\t";
+                    std::cout << var << "\t";
                 }
             }
             if (i!=wordLengthBoundSoFar) std::cout << "\n"; else std::cout << "]\n";
@@ -347,65 +817,248 @@ void SatisfiabilityChecker::printAPtoSATMapping() {
     std::cout.flush();
 }
 
-void SatisfiabilityChecker::addTemporalOperatorsNeededForTheEncoding() {
-    // For every <A>... formula, we must also have a <B'>... formula
-    std::set<boost::tuple<FormulaType,std::set<int> > > subformulasToBeAdded;
-    for (auto it = formulaFactory.getFormulaNrs().begin();it!=formulaFactory.getFormulaNrs().end();it++) {
-        if (it->first.get<0>()==TF_DIAMOND_A) {
-            subformulasToBeAdded.insert(boost::make_tuple(TF_DIAMOND_B_BAR,it->first.get<1>()));
-        } else if (it->first.get<0>()==TF_BOX_A) {
-            subformulasToBeAdded.insert(boost::make_tuple(TF_BOX_B_BAR,it->first.get<1>()));
-        } else if (it->first.get<0>()==TF_DIAMOND_A_BAR) {
-            subformulasToBeAdded.insert(boost::make_tuple(TF_DIAMOND_E_BAR,it->first.get<1>()));
-        } else if (it->first.get<0>()==TF_BOX_A_BAR) {
-            subformulasToBeAdded.insert(boost::make_tuple(TF_BOX_E_BAR,it->first.get<1>()));
+void SatisfiabilityChecker::addTemporalOperatorsNeededForTheEncoding(FormulaFactory &factory) {
+    // For every <A>... formula, we must also have a <B'>... formula. The same holds for the natively encoded
+    // L and O operators, while L' and O' need an <E'>... formula.
+    unsigned int nofFormulas = factory.getNofFormulas();
+    for (unsigned int subformula=0;subformula<nofFormulas;subformula++) {
+        FormulaChildren params = factory.getChildren(subformula);
+        FormulaType partnerType;
+        if (FormulaFactory::getEncodingPartnerType(factory.getFormulaType(subformula),partnerType)) {
+            factory.insertSubformula(partnerType,params);
         }
     }
-    for (auto it = subformulasToBeAdded.begin();it!=subformulasToBeAdded.end();it++) {
-        formulaFactory.insertSubformula(*it);
+}
+
+
+/**
+ * @brief Translates the formula table into a flat list of instructions for the SAT encoder, so that extending the
+ *        encoding to a new bound does not need to look up anything in the formula factory. Must be called after
+ *        "addTemporalOperatorsNeededForTheEncoding", as the partner subformulas of the A, L, and O operators are
+ *        resolved here.
+ */
+void SatisfiabilityChecker::compileEncodingProgram() {
+    encodingProgram.clear();
+    encodingChildren.clear();
+    for (unsigned int subformula=0;subformula<factory.getNofFormulas();subformula++) {
+        EncodingInstruction instruction;
+        instruction.type = factory.getFormulaType(subformula);
+        instruction.subformula = subformula;
+        instruction.child = 0;
+        instruction.partner = 0;
+        instruction.childrenBegin = encodingChildren.size();
+        FormulaChildren params = factory.getChildren(subformula);
+        encodingChildren.insert(encodingChildren.end(),params.begin(),params.end());
+        instruction.childrenEnd = encodingChildren.size();
+        if ((instruction.type!=TF_AND) && (instruction.type!=TF_OR)) {
+            instruction.child = factory.getSingleParameterOfTemporalSubformula(subformula);
+        }
+        if ((instruction.type==TF_NOT) && (instruction.child>=0)) {
+            throw std::string("TF_NOT may only be applied to atomic propositions!");
+        }
+
+        // Partner subformulas
+        FormulaType partnerType;
+        if (FormulaFactory::getEncodingPartnerType(instruction.type,partnerType)) {
+            instruction.partner = factory.findSubformula(partnerType,params);
+            assert(instruction.partner!=FormulaFactory::NO_SUBFORMULA);
+        }
+        encodingProgram.push_back(instruction);
     }
 }
 
-void SatisfiabilityChecker::run(int maxBound) {
-    if ((maxBound<1) && (maxBound!=-1)) {
-        throw std::string("Maximum bound must be at least 1.");
+/**
+ * @brief Computes a word length such that the formula has a model of at most this length if it is satisfiable at all,
+ *        or -1 if the formula is not in a fragment for which such a bound is known. The fragment consists of the
+ *        formulas in which no diamond operator occurs below a box operator.
+ *
+ *        Restricting a model to a subset of its points (that contains the first one) keeps all relations between the
+ *        intervals over the remaining points, as they only depend on the order of the end points. Box formulas without
+ *        diamonds hence stay true on such intervals, and so do the diamond formulas outside of boxes if the end points
+ *        of their witness intervals are kept. A diamond adds at most one new point (two for the L, D, and O operators)
+ *        for every witness, where a conjunction needs the witnesses of all of its parameters, and a disjunction those
+ *        of one of them. Must be called after "compileEncodingProgram".
+ */
+int SatisfiabilityChecker::computeCompletenessThreshold() const {
+    const long long tooLarge = 1LL << 30; // Such thresholds would not help anyway, and the sums cannot overflow
+    if (mainFormulaNumber<0) return 1;
+    std::vector<long long> nofPoints(encodingProgram.size(),0); // -1 if outside the fragment
+    std::vector<bool> hasDiamond(encodingProgram.size(),false);
+    for (unsigned int subformula=0;subformula<=(unsigned int)mainFormulaNumber;subformula++) {
+        const EncodingInstruction &instruction = encodingProgram[subformula];
+        long long &points = nofPoints[subformula];
+        if ((instruction.type==TF_AND) || (instruction.type==TF_OR)) {
+            for (int k=instruction.childrenBegin;k<instruction.childrenEnd;k++) {
+                int child = encodingChildren[k];
+                if (child<0) continue;
+                hasDiamond[subformula] = hasDiamond[subformula] || hasDiamond[child];
+                if ((points==-1) || (nofPoints[child]==-1)) {
+                    points = -1;
+                } else if (instruction.type==TF_AND) {
+                    points = std::min(points+nofPoints[child],tooLarge);
+                } else {
+                    points = std::max(points,nofPoints[child]);
+                }
+            }
+        } else if (instruction.type>=FIRST_BOX_FORMULA_TYPE) {
+            if ((instruction.child>=0) && (hasDiamond[instruction.child] || (nofPoints[instruction.child]==-1))) points = -1;
+        } else if (instruction.type!=TF_NOT) {
+            hasDiamond[subformula] = true;
+            int newPoints = ((instruction.type==TF_DIAMOND_L) || (instruction.type==TF_DIAMOND_L_BAR) || (instruction.type==TF_DIAMOND_D) || (instruction.type==TF_DIAMOND_D_BAR) || (instruction.type==TF_DIAMOND_O) || (instruction.type==TF_DIAMOND_O_BAR))?2:1;
+            long long childPoints = (instruction.child<0)?0:nofPoints[instruction.child];
+            points = (childPoints==-1)?-1:std::min(childPoints+newPoints,tooLarge);
+        }
     }
+    long long threshold = nofPoints[mainFormulaNumber]+1;
+    if ((threshold==0) || (threshold>=tooLarge)) return -1;
+    return (int)threshold;
+}
 
-    mainFormulaNumber = formulaFactory.makePositiveNormalForm(mainFormulaNumber);
+/**
+ * @brief Brings the formula into the form needed by the SAT encoding. Must be called once before the first checker for
+ *        the formula is created, as the formula factory is read-only afterwards.
+ * @param simplify whether the formula is simplified (see FormulaFactory::simplify) before it is encoded
+ * @param nativeDerivedOperators whether the derived operators L, D, and O are encoded natively, rather than being
+ *        expressed by the other operators (see FormulaFactory::encodeDerivedTemporalOperators)
+ * @return the new handle of the main formula
+ */
+int SatisfiabilityChecker::prepareFormula(FormulaFactory &factory, int mainFormulaNumber, bool verbose, bool simplify, bool nativeDerivedOperators, const PhaseTimingCallback &timingCallback) {
+    PhaseTimer timer(timingCallback,"positive normal form",-1);
+    mainFormulaNumber = factory.makePositiveNormalForm(mainFormulaNumber);
     // The following three steps have to be performed in this order: first encode all derived temporal operators
     // as pure ones - this may leave some unused subformulas. Then remove them, as the SAT encoding encodes all
     // operators in the formula table. Finally, add helping subformulas for the encoding. These are technically
     // not connected to the rest of the formulas, so "removeUnreachableSubformulas" must not be called afterwards.
-    // Also, removeUnreachableSubformulas must be called as the SAT encoder cannot encode derived operators, so this
-    // would lead to an error otherwise.
+    // Also, removeUnreachableSubformulas must be called if the derived operators are desugared, as the original
+    // derived operators would still be encoded otherwise. The SAT encoder can encode the derived operators L, D, and
+    // O (and their inverses) natively, in which case they are kept.
+
+    if (!nativeDerivedOperators) {
+        timer.switchTo("derived operators");
+        mainFormulaNumber = factory.encodeDerivedTemporalOperators(mainFormulaNumber);
+    }
+    if (verbose) std::cout << "Formula size: " << factory.getNofFormulas() << std::endl;
+    timer.switchTo("remove unreachable");
+    mainFormulaNumber = factory.removeUnreachableSubformulas(mainFormulaNumber);
+    if (simplify) {
+        // Simplification works on formulas in positive normal form, and may leave unused subformulas again
+        if (verbose) std::cout << "Formula size before simplification: " << factory.getNofFormulas() << std::endl;
+        timer.switchTo("simplify");
+        mainFormulaNumber = factory.simplify(mainFormulaNumber);
+        timer.switchTo("remove unreachable");
+        mainFormulaNumber = factory.removeUnreachableSubformulas(mainFormulaNumber);
+        if (verbose) std::cout << "Formula size after simplification: " << factory.getNofFormulas() << std::endl;
+    }
+    timer.switchTo("helper subformulas");
+    addTemporalOperatorsNeededForTheEncoding(factory);
+    if (verbose) std::cout << "Formula size after encoding: " << factory.getNofFormulas() << std::endl;
+    return mainFormulaNumber;
+}
+
+void SatisfiabilityChecker::run(int maxBound, BoundStrategy strategy) {
+    if ((maxBound<1) && (maxBound!=-1)) {
+        throw std::string("Maximum bound must be at least 1.");
+    }
+    if (completenessThreshold!=-1) {
+        std::cerr << "Completeness threshold: " << completenessThreshold << std::endl;
+    }
+    switch (strategy) {
+    case BS_LINEAR: runLinear(maxBound); break;
+    case BS_GALLOPING: runGalloping(maxBound); break;
+    case BS_DIRECT: runDirect(maxBound); break;
+    }
+}
+
+/**
+ * @brief Prints the result of a run that has been stopped by a resource limit
+ */
+void SatisfiabilityChecker::reportResourceLimit(const std::string &provenFacts) {
+    std::cerr << "Result: Unknown - the " << resourceLimitReached << " has been reached. " << provenFacts << std::endl;
+}
 
-    mainFormulaNumber = formulaFactory.encodeDerivedTemporalOperators(mainFormulaNumber);
-    std::cout << "Formula size: " << formulaFactory.getFormulaNrs().size() << std::endl;
-    mainFormulaNumber = formulaFactory.removeUnreachableSubformulas(mainFormulaNumber);
-    addTemporalOperatorsNeededForTheEncoding();
-    std::cout << "Formula size after encoding: " << formulaFactory.getFormulaNrs().size() << std::endl;
+/**
+ * @brief Creates a checker with the same settings for the same formula, which can be used for checking bounds that are
+ *        smaller than the ones checked with this checker so far. The new checker shares the deadline of this one, but
+ *        gets a conflict budget of its own.
+ */
+SatisfiabilityChecker *SatisfiabilityChecker::createFreshChecker() {
+    SatisfiabilityChecker *checker = new SatisfiabilityChecker(factory,mainFormulaNumber,satSolverBackend);
+    checker->setUseActivationLiterals(useActivationLiterals);
+    checker->setUseSymmetryBreaking(symmetries.get()!=NULL);
+    checker->setValidateCertificates(validateCertificates);
+    if (terminateCallback) checker->setTerminateCallback(terminateCallback);
+    checker->setPhaseTimingCallback(phaseTimingCallback);
+    checker->setStatisticsCallback(statisticsCallback);
+    checker->setResourceLimits(resourceLimits);
+    checker->deadline = deadline;
+    return checker;
+}
+
+/**
+ * @brief Checks the word lengths 1, 2, 3, ... one after the other, so the first model found is of minimal length
+ */
+void SatisfiabilityChecker::runLinear(int maxBound) {
+    // Results of earlier runs
+    if (resultCache) {
+        if ((cachedResult.modelLength!=-1) && ((maxBound==-1) || (cachedResult.modelLength<=maxBound))) {
+            modelFromResultCache = true;
+            std::cerr << "Taking the result from the result cache" << std::endl;
+            std::cerr << "Result: The temporal logic formula is satisfiable for a word of length " << cachedResult.modelLength << std::endl;
+            printSimplifiedSatisfiabilityCertificate();
+            return;
+        }
+        if (cachedResult.unsatisfiableForAllLengths) {
+            std::cerr << "Result: The temporal logic formula is unsatisfiable - according to the result cache" << std::endl;
+            return;
+        }
+        if (cachedResult.largestUnsatisfiableBound>0) {
+            std::cerr << "According to the result cache, there is no model of length up to " << cachedResult.largestUnsatisfiableBound << std::endl;
+        }
+    }
 
     // The loop
     while (true) {
-        int newSize = wordLengthBoundSoFar+1;
+        int newSize = std::max(wordLengthBoundSoFar+1,cachedResult.largestUnsatisfiableBound+1);
         if (newSize==0) newSize+=1; // Words must have length at least 0, otherwise the semantics of the BOX operator is a bit unclear
-        if (maxBound+1==newSize) {
+        if ((completenessThreshold!=-1) && (newSize>completenessThreshold)) {
+            std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model of length up to " << completenessThreshold << ", and the formula would have one if it was satisfiable" << std::endl;
+            updateResultCache(BoundSearchResult::UNSATISFIABLE,completenessThreshold);
+            return;
+        }
+        if ((maxBound!=-1) && (newSize>maxBound)) {
             std::cerr << "Result: Aborting due to reaching the maximum bound of " << maxBound << std::endl;
+            updateResultCache(BoundSearchResult::NO_MODEL_UP_TO_MAX_BOUND,maxBound);
             return;
         }
         std::cerr << "Trying a word of length " << newSize << std::endl;
         //printSubformulaSATMapping();
 
-        extendWordLengthBound(newSize);
-
-        bool isSAT = checkSatisfiabilityUnderBound();
-        if (isSAT) {
+        IncrementalSATSolver::Result result = checkBound(newSize);
+        if ((result==IncrementalSATSolver::UNKNOWN) && (resourceLimitReached!=NULL)) {
+            std::ostringstream provenFacts;
+            if (newSize==1) {
+                provenFacts << "No word length has been checked completely.";
+            } else {
+                provenFacts << "There is no model of length up to " << newSize-1 << ".";
+            }
+            reportResourceLimit(provenFacts.str());
+            updateResultCache(BoundSearchResult::UNKNOWN,newSize-1);
+            return;
+        }
+        if (unsatisfiableForLongerWords) {
+            std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model shorter than " << newSize << ", and the contradiction found for this length does not depend on the word length" << std::endl;
+            std::cerr << "We needed " << nofVariablesSoFar << " SAT Variables and " << nofClausesSoFar << " clauses\n";
+            updateResultCache(BoundSearchResult::UNSATISFIABLE,newSize);
+            return;
+        }
+        if (result==IncrementalSATSolver::SATISFIABLE) {
             std::cerr << "Result: The temporal logic formula is satisfiable for a word of length " << newSize << std::endl;
             std::cerr << "We needed " << nofVariablesSoFar << " SAT Variables and " << nofClausesSoFar << " clauses\n";
             //printAPtoSATMapping();
             printSimplifiedSatisfiabilityCertificate();
             //printSatisfiabilityCertificate();
             //printAssignment();
+            updateResultCache(BoundSearchResult::SATISFIABLE,newSize);
             return;
         } else {
             //printAPtoSATMapping();
@@ -414,10 +1067,188 @@ void SatisfiabilityChecker::run(int maxBound) {
     }
 }
 
+/**
+ * @brief Same search as "runLinear", but without any output, for checking many formulas within one process
+ */
+BoundSearchResult SatisfiabilityChecker::searchMinimalModel(int maxBound) {
+    BoundSearchResult result;
+    result.nofVariables = nofVariablesSoFar;
+    result.nofClauses = nofClausesSoFar;
+    if (resultCache) {
+        if ((cachedResult.modelLength!=-1) && ((maxBound==-1) || (cachedResult.modelLength<=maxBound))) {
+            modelFromResultCache = true;
+            result.status = BoundSearchResult::SATISFIABLE;
+            result.bound = cachedResult.modelLength;
+            return result;
+        }
+        if (cachedResult.unsatisfiableForAllLengths) {
+            result.status = BoundSearchResult::UNSATISFIABLE;
+            result.bound = cachedResult.largestUnsatisfiableBound;
+            return result;
+        }
+    }
+    result.status = BoundSearchResult::NO_MODEL_UP_TO_MAX_BOUND;
+    result.bound = std::max(std::max(wordLengthBoundSoFar,cachedResult.largestUnsatisfiableBound),0);
+    if ((maxBound!=-1) && (result.bound>maxBound)) result.bound = maxBound;
+    for (int bound=std::max(wordLengthBoundSoFar,cachedResult.largestUnsatisfiableBound)+1;(maxBound==-1) || (bound<=maxBound);bound++) {
+        if (bound==0) continue;
+        if ((completenessThreshold!=-1) && (bound>completenessThreshold)) break;
+        if (terminateCallback && terminateCallback()) {
+            result.status = BoundSearchResult::CANCELLED;
+            break;
+        }
+        IncrementalSATSolver::Result solverResult = checkBound(bound);
+        if (progressCallback) progressCallback(bound,solverResult);
+        if (solverResult==IncrementalSATSolver::SATISFIABLE) {
+            result.status = BoundSearchResult::SATISFIABLE;
+            result.bound = bound;
+            break;
+        } else if (unsatisfiableForLongerWords) {
+            result.status = BoundSearchResult::UNSATISFIABLE;
+            result.bound = bound;
+            break;
+        } else if (solverResult==IncrementalSATSolver::UNKNOWN) {
+            result.status = (resourceLimitReached!=NULL)?BoundSearchResult::UNKNOWN:BoundSearchResult::CANCELLED;
+            break;
+        }
+        result.bound = bound;
+    }
+    if ((result.status==BoundSearchResult::NO_MODEL_UP_TO_MAX_BOUND) && (completenessThreshold!=-1) && (result.bound>=completenessThreshold)) {
+        result.status = BoundSearchResult::UNSATISFIABLE;
+    }
+    updateResultCache(result.status,result.bound);
+    result.nofVariables = nofVariablesSoFar;
+    result.nofClauses = nofClausesSoFar;
+    return result;
+}
+
+/**
+ * @brief Checks the word lengths 1, 2, 4, 8, ... until a model is found, and then searches for the smallest length
+ *        between the last unsatisfiable length and the satisfiable one by bisection. The search reuses the incremental
+ *        checkers whenever the next length is larger than the last one they checked, and starts from a fresh checker
+ *        otherwise. As satisfiability is not monotone in the word length, the model found is only guaranteed to be one
+ *        longer than a word length for which there is no model, but not to be of minimal length.
+ *
+ *        If the formula has a completeness threshold, all word lengths up to it are checked one after the other instead,
+ *        as the formula can only be found to be unsatisfiable after checking all of them. The model found is then of
+ *        minimal length.
+ */
+void SatisfiabilityChecker::runGalloping(int maxBound) {
+    std::vector<boost::shared_ptr<SatisfiabilityChecker> > freshCheckers;
+    SatisfiabilityChecker *current = this;
+    SatisfiabilityChecker *modelChecker = NULL;
+    int unsatBound = 0;
+    int satBound = -1;
+    bool checkAllLengths = completenessThreshold!=-1;
+    int lastBound = maxBound;
+    if (checkAllLengths && ((maxBound==-1) || (completenessThreshold<maxBound))) lastBound = completenessThreshold;
+
+    // Galloping phase
+    int bound = 1;
+    while (satBound==-1) {
+        if ((lastBound!=-1) && (bound>lastBound)) {
+            if (unsatBound==lastBound) {
+                if (!checkAllLengths) {
+                    std::cerr << "Result: No model has been found for the word lengths checked up to the maximum bound of " << maxBound << " (not all lengths have been checked)" << std::endl;
+                } else if (lastBound==completenessThreshold) {
+                    std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model of length up to " << completenessThreshold << ", and the formula would have one if it was satisfiable" << std::endl;
+                } else {
+                    std::cerr << "Result: Aborting due to reaching the maximum bound of " << maxBound << std::endl;
+                }
+                return;
+            }
+            bound = lastBound;
+        }
+        std::cerr << "Trying a word of length " << bound << std::endl;
+        IncrementalSATSolver::Result result = current->checkBound(bound);
+        if ((result==IncrementalSATSolver::UNKNOWN) && (resourceLimitReached!=NULL)) {
+            std::ostringstream provenFacts;
+            if (unsatBound==0) {
+                provenFacts << "No word length has been checked completely.";
+            } else if (checkAllLengths) {
+                provenFacts << "There is no model of length up to " << unsatBound << ".";
+            } else {
+                provenFacts << "There is no model of length " << unsatBound << " (not all shorter lengths have been checked).";
+            }
+            reportResourceLimit(provenFacts.str());
+            return;
+        }
+        if (current->unsatisfiableForLongerWords) {
+            if (checkAllLengths || (bound==1)) {
+                std::cerr << "Result: The temporal logic formula is unsatisfiable - there is no model shorter than " << bound << ", and the contradiction found for this length does not depend on the word length" << std::endl;
+            } else {
+                std::cerr << "Result: The temporal logic formula has no model of length " << bound << " or longer (not all shorter lengths have been checked)" << std::endl;
+            }
+            return;
+        }
+        if (result==IncrementalSATSolver::SATISFIABLE) {
+            satBound = bound;
+            modelChecker = current;
+        } else {
+            unsatBound = bound;
+            bound = checkAllLengths?bound+1:bound*2;
+        }
+    }
+
+    // Bisection phase. The checker that found the last model is never extended any further, so its model stays available.
+    while (satBound-unsatBound>1) {
+        int middle = (satBound+unsatBound)/2;
+        if (current->getWordLengthBound()>=middle) {
+            freshCheckers.push_back(boost::shared_ptr<SatisfiabilityChecker>(createFreshChecker()));
+            current = freshCheckers.back().get();
+        }
+        std::cerr << "Trying a word of length " << middle << std::endl;
+        IncrementalSATSolver::Result result = current->checkBound(middle);
+        if ((result==IncrementalSATSolver::UNKNOWN) && (current->resourceLimitReached!=NULL)) {
+            std::ostringstream provenFacts;
+            provenFacts << "The temporal logic formula has a model of length " << satBound << ", but none of length " << unsatBound << " (shorter models may exist).";
+            current->reportResourceLimit(provenFacts.str());
+            std::cerr << "We needed " << modelChecker->nofVariablesSoFar << " SAT Variables and " << modelChecker->nofClausesSoFar << " clauses\n";
+            modelChecker->printSimplifiedSatisfiabilityCertificate();
+            return;
+        }
+        if (result==IncrementalSATSolver::SATISFIABLE) {
+            satBound = middle;
+            modelChecker = current;
+        } else {
+            unsatBound = middle;
+        }
+    }
+
+    if ((satBound==1) || checkAllLengths) {
+        std::cerr << "Result: The temporal logic formula is satisfiable for a word of length " << satBound << std::endl;
+    } else {
+        std::cerr << "Result: The temporal logic formula has a model of length " << satBound << ", but none of length " << unsatBound << " (shorter models may exist)" << std::endl;
+    }
+    std::cerr << "We needed " << modelChecker->nofVariablesSoFar << " SAT Variables and " << modelChecker->nofClausesSoFar << " clauses\n";
+    modelChecker->printSimplifiedSatisfiabilityCertificate();
+}
+
+/**
+ * @brief Only checks the maximum bound, without trying shorter word lengths
+ */
+void SatisfiabilityChecker::runDirect(int maxBound) {
+    if (maxBound==-1) {
+        throw std::string("The direct bound strategy needs a maximum bound.");
+    }
+    std::cerr << "Trying a word of length " << maxBound << std::endl;
+    IncrementalSATSolver::Result result = checkBound(maxBound);
+    if ((result==IncrementalSATSolver::UNKNOWN) && (resourceLimitReached!=NULL)) {
+        reportResourceLimit("No word length has been checked completely.");
+    } else if (result==IncrementalSATSolver::SATISFIABLE) {
+        std::cerr << "Result: The temporal logic formula has a model of length " << maxBound << " (shorter models have not been searched for)" << std::endl;
+        std::cerr << "We needed " << nofVariablesSoFar << " SAT Variables and " << nofClausesSoFar << " clauses\n";
+        printSimplifiedSatisfiabilityCertificate();
+    } else if (unsatisfiableForLongerWords) {
+        std::cerr << "Result: The temporal logic formula has no model of length " << maxBound << " or longer (shorter lengths have not been checked)" << std::endl;
+    } else {
+        std::cerr << "Result: The temporal logic formula has no model of length " << maxBound << " (other lengths have not been checked)" << std::endl;
+    }
+}
+
 void SatisfiabilityChecker::printAssignment() {
-    int maxVar = picosat_inc_max_var(picosat);
-    for (int i=1;i<maxVar;i++) {
-        if (picosat_deref(picosat,i)==1) {
+    for (int i=1;i<=nofSATVariablesUsedSoFar;i++) {
+        if (solver->getValue(i)) {
             std::cout << i << " ";
         } else {
             std::cout << -1*i << " ";
@@ -441,17 +1272,17 @@ void SatisfiabilityChecker::printSatisfiabilityCertificate() {
     std::cout << "\n\n";*/
 
     // Atomic propositions
-    for (auto it = formulaFactory.getAPNrs().begin();it!=formulaFactory.getAPNrs().end();it++) {
+    for (auto it = factory.getAPNrs().begin();it!=factory.getAPNrs().end();it++) {
         std::set<std::pair<int,int> > intervals;
         std::cout << "AP: " << it->first << std::endl;
         for (int i=0;i<=wordLengthBoundSoFar;i++) {
             for (int j=i;j<=wordLengthBoundSoFar;j++) {
-                auto finder = satInstanceSubformulaMapping.find(boost::make_tuple(it->second,i,j));
-                if (finder == satInstanceSubformulaMapping.end()) {
+                int var = variables.get(it->second,i,j);
+                if (var==0) {
                     // Don't care
                 } else {
                     // Holds on the interval?
-                    if (picosat_deref(picosat,finder->second)==1) {
+                    if (solver->getValue(var)) {
                         intervals.insert(std::pair<int,int>(i,j-i));
                     }
                 }
@@ -461,18 +1292,18 @@ void SatisfiabilityChecker::printSatisfiabilityCertificate() {
         std::cout << std::endl;
     }
 
-    for (auto it = formulaFactory.getFormulaNrs().begin();it!=formulaFactory.getFormulaNrs().end();it++) {
-        std::cout << "Subformula: " << it->second << std::endl;
+    for (unsigned int subformula=0;subformula<factory.getNofFormulas();subformula++) {
+        std::cout << "Subformula: " << subformula << std::endl;
         std::set<std::pair<int,int> > intervals;
-        formulaFactory.printFormula(it->second,0);
+        factory.printFormula(subformula,0);
         for (int i=0;i<=wordLengthBoundSoFar;i++) {
             for (int j=i;j<=wordLengthBoundSoFar;j++) {
-                auto finder = satInstanceSubformulaMapping.find(boost::make_tuple(it->second,i,j));
-                if (finder == satInstanceSubformulaMapping.end()) {
+                int var = variables.get(subformula,i,j);
+                if (var==0) {
                     // Don't care
                 } else {
                     // Holds on the interval?
-                    if (picosat_deref(picosat,finder->second)==1) {
+                    if (solver->getValue(var)) {
                         intervals.insert(std::pair<int,int>(i,j-i));
                     }
                 }
@@ -486,41 +1317,62 @@ void SatisfiabilityChecker::printSatisfiabilityCertificate() {
     std::cout.flush();
 }
 
+/**
+ * @brief Extracts the model found in the last satisfiable check: for every atomic proposition, the intervals (from,to)
+ *        on which it holds, sorted by their start and end points.
+ */
+std::map<std::string,std::vector<std::pair<int,int> > > SatisfiabilityChecker::getModel() {
+    if (modelFromResultCache) return cachedResult.certificate;
+    std::map<std::string,std::vector<std::pair<int,int> > > model;
+    for (auto it = factory.getAPNrs().begin();it!=factory.getAPNrs().end();it++) {
+        std::vector<std::pair<int,int> > &intervals = model[it->first];
+        for (int i=0;i<=wordLengthBoundSoFar;i++) {
+            for (int j=i;j<=wordLengthBoundSoFar;j++) {
+                int var = variables.get(it->second,i,j);
+                if ((var!=0) && solver->getValue(var)) {
+                    intervals.push_back(std::pair<int,int>(i,j));
+                }
+            }
+        }
+    }
+    return model;
+}
+
+/**
+ * @brief Checks the model found in the last bound with the "CertificateValidator", i.e., independently of the SAT encoding
+ */
+bool SatisfiabilityChecker::validateModel() {
+    return CertificateValidator::validate(factory,mainFormulaNumber,getModelLength(),getModel());
+}
+
 void SatisfiabilityChecker::printSimplifiedSatisfiabilityCertificate() {
 
     // Basic certificate information
     std::cout << "\n\n=====================[Satisfiability Certificate]==============================\n";
-    /*std::cout << "Time line:\n";
-    if (wordLengthBoundSoFar==1) {
-        std::cout << "|";
-    } else {
-        std::cout << "|";
-        for (int i=0;i<wordLengthBoundSoFar-2;i++) std::cout << "-";
-        std::cout << "|";
-    }
-    std::cout << "\n\n";*/
 
     // Atomic propositions
-    for (auto it = formulaFactory.getAPNrs().begin();it!=formulaFactory.getAPNrs().end();it++) {
+    std::map<std::string,std::vector<std::pair<int,int> > > model = getModel();
+    for (auto it = model.begin();it!=model.end();it++) {
         std::set<std::pair<int,int> > intervals;
         std::cout << "AP: " << it->first << std::endl;
-        for (int i=0;i<=wordLengthBoundSoFar;i++) {
-            for (int j=i;j<=wordLengthBoundSoFar;j++) {
-                auto finder = satInstanceSubformulaMapping.find(boost::make_tuple(it->second,i,j));
-                if (finder == satInstanceSubformulaMapping.end()) {
-                    // Don't care
-                } else {
-                    // Holds on the interval?
-                    if (picosat_deref(picosat,finder->second)==1) {
-                        intervals.insert(std::pair<int,int>(i,j-i));
-                    }
-                }
-            }
+        for (auto it2 = it->second.begin();it2!=it->second.end();it2++) {
+            intervals.insert(std::pair<int,int>(it2->first,it2->second-it2->first));
         }
         drawIntervals(intervals);
         std::cout << std::endl;
     }
 
+    // Independent check of the certificate
+    if (validateCertificates) {
+        auto startTime = std::chrono::steady_clock::now();
+        bool valid = CertificateValidator::validate(factory,mainFormulaNumber,getModelLength(),model);
+        double time = std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-startTime).count();
+        if (!valid) {
+            std::cout.flush();
+            throw std::string("The certificate does not satisfy the formula.");
+        }
+        std::cout << "Certificate validated in " << time << " ms" << std::endl;
+    }
 
     // Done!
     std::cout.flush();
@@ -2,12 +2,95 @@
 #define __SAT_CHECKER_HPP__
 
 #include "formulaFactory.hpp"
+#include "satVariableTable.hpp"
+#include "abstractSatisfiabilityChecker.hpp"
+#include "symmetryDetector.hpp"
+#include "certificateValidator.hpp"
+#include "resultCache.hpp"
+#include "satSolver.hpp"
 #include <map>
+#include <chrono>
 #include <boost/tuple/tuple.hpp>
 #include <boost/smart_ptr.hpp>
-extern "C" {
-  #include "picosat.h"
-}
+
+class ICNFWriter;
+
+/**
+ * @brief One instruction of the precompiled encoding program: describes which clauses have to be added for a
+ *        subformula on every interval.
+ */
+struct EncodingInstruction {
+    FormulaType type;
+    int subformula;
+    int child; // Only parameter of unary operators
+    int partner; // <B'>/<E'>/[B']/[E'] subformula used for encoding the A, L, and O operators
+    int childrenBegin; // Range of the parameters in "encodingChildren"
+    int childrenEnd;
+};
+
+/**
+ * @brief How the word lengths to be checked are chosen. Only the linear strategy guarantees that the models found
+ *        are of minimal length, as a formula can be satisfiable for some word length, but not for a larger one.
+ */
+typedef enum { BS_LINEAR, BS_GALLOPING, BS_DIRECT } BoundStrategy;
+
+/**
+ * @brief Outcome of "SatisfiabilityChecker::searchMinimalModel"
+ */
+struct BoundSearchResult {
+    // UNKNOWN: a resource limit has been reached, UNSATISFIABLE: there is no model of any length
+    typedef enum { SATISFIABLE, NO_MODEL_UP_TO_MAX_BOUND, CANCELLED, UNKNOWN, UNSATISFIABLE } Status;
+    Status status;
+    int bound; // The minimal model length, or the largest bound without a model (for UNSATISFIABLE: the last bound that had to be checked)
+    int nofVariables;
+    int nofClauses;
+};
+
+/**
+ * @brief Limits on the resources that a "SatisfiabilityChecker" may use. Once one of them is reached, the checker stops
+ *        with an unknown result. The time is counted from the call to "setResourceLimits", and the memory is the
+ *        resident memory of the whole process. The limits are checked between the phases of every bound and while the
+ *        SAT solver runs. Negative values denote that there is no limit.
+ */
+struct ResourceLimits {
+    double timeout; // In seconds
+    long long conflictBudget; // Over all bounds - counted as decisions with PicoSAT
+    long long memoryLimit; // In bytes
+    ResourceLimits() : timeout(-1), conflictBudget(-1), memoryLimit(-1) {}
+};
+
+/**
+ * @brief Measurements for one bound checked by a "SatisfiabilityChecker", as reported to its statistics callback. Times
+ *        are in seconds, the counters of the SAT solver are the ones for this bound only (or -1 if the solver does not
+ *        provide them), and memory sizes are in bytes.
+ */
+struct BoundStatistics {
+    int bound;
+    IncrementalSATSolver::Result result;
+    double encodingTime;
+    double abstractionTime;
+    double solvingTime;
+    int newVariables;
+    int newClauses;
+    int nofAssumptions;
+    int nofFailedAssumptions; // -1 unless the bound is unsatisfiable
+    bool unsatisfiableForLongerWords; // The contradiction does not depend on any assumption of the bound
+    IncrementalSATSolver::Statistics solver;
+    size_t formulaMemory;
+    size_t variableTableMemory; // Including the other tables indexed by the intervals
+    size_t abstractionMemory;
+    long long solverMemory;
+    long long residentMemory; // Of the whole process, or -1 if unknown
+    BoundStatistics();
+    std::string toJSON() const;
+};
+
+/**
+ * @brief Receives the time (in seconds) that a phase of the satisfiability check took, for benchmarking. The bound is
+ *        -1 for the phases of "SatisfiabilityChecker::prepareFormula". Phases may be reported several times per bound,
+ *        in which case the times add up.
+ */
+typedef std::function<void(const char *phase, int bound, double seconds)> PhaseTimingCallback;
 
 /**
  * @brief The main class for the satisfiability check of an ITL formula.
@@ -15,9 +98,26 @@ extern "C" {
  */
 class SatisfiabilityChecker {
 private:
+    /**
+     * @brief The formula factory is only read from after "prepareFormula" has been run, so that it can be shared
+     *        between several checkers running in parallel
+     */
+    const FormulaFactory &factory;
+
     // SAT Solving variables
-    PicoSAT *picosat;
-    int nofPicosatVariablesUsedSoFar;
+    boost::scoped_ptr<IncrementalSATSolver> unwrappedSolver; // Only used if the solver has been wrapped (by an ICNFWriter)
+    boost::scoped_ptr<IncrementalSATSolver> solver;
+    std::string satSolverBackend;
+    std::function<bool()> terminateCallback;
+    ResourceLimits resourceLimits;
+    std::chrono::steady_clock::time_point deadline;
+    std::chrono::steady_clock::time_point nextResourceCheck;
+    const char *resourceLimitReached; // NULL as long as no limit has been reached
+    std::function<void(int,IncrementalSATSolver::Result)> progressCallback;
+    PhaseTimingCallback phaseTimingCallback;
+    std::function<void(const BoundStatistics &)> statisticsCallback;
+    BoundStatistics boundStatistics; // Of the bound that is being checked
+    int nofSATVariablesUsedSoFar;
 
     // SAT Encoding Variables
     int wordLengthBoundSoFar;
@@ -27,26 +127,140 @@ private:
     /**
      * @brief Maps from Subformula-ID x Interval-Start x Interval-End to SAT variable
      */
-    std::map<boost::tuple<int,int,int>,int> satInstanceSubformulaMapping;
+    SatVariableTable variables;
+
+    /**
+     * @brief Stores for every subformula and interval which of its clauses have already been added to the SAT solver:
+     *        bit 0 for the clauses implied by the interval itself, and bit 1 for the clauses implied by (i,j-1)
+     */
+    SatVariableTable encodedCells;
+
+    /**
+     * @brief Literals that fix the intervals touching the boundary of the word in the current bound
+     */
+    std::vector<int> boundaryFrontier;
+
+    /**
+     * @brief Literals that fix the intervals found to be trivial by the abstract satisfiability checker in the current bound
+     */
+    std::vector<int> abstractionAssumptions;
+
+    /**
+     * @brief The abstract satisfiability checker is kept over all bounds, as most of its results stay valid
+     */
+    boost::scoped_ptr<AbstractSatisfiabilityChecker> abstractor;
+
+    /**
+     * @brief Symmetries of the formula, for which lexicographic-leader clauses are added (only if enabled). The clauses
+     *        compare the AP variables in the order in which they have been allocated, "comparedAPVariables" stores 1 for
+     *        the AP variables compared so far, and "symmetryBreakingChains" stores per generator the literal stating that
+     *        all of them are equal to their images (or 0 if nothing has been compared yet).
+     */
+    boost::scoped_ptr<SymmetryDetector> symmetries;
+    SatVariableTable comparedAPVariables;
+    std::vector<int> symmetryBreakingChains;
+
+    // Guarding the facts of a bound by a single activation literal instead of assuming them separately
+    bool useActivationLiterals;
+    int activationLiteral;
+
+    // Checking the certificates printed with the "CertificateValidator"
+    bool validateCertificates;
+
+    /**
+     * @brief Set once the SAT solver has found a contradiction that does not depend on any of the assumptions of the
+     *        bound. As the clauses added to the solver stay valid for all larger bounds, there is then no model of this or
+     *        any larger length.
+     */
+    bool unsatisfiableForLongerWords;
+
+    /**
+     * @brief If the formula has a model, it has one of at most this length (-1 if unknown). Checking the lengths up to
+     *        this one thus suffices for proving that the formula is unsatisfiable.
+     */
+    int completenessThreshold;
+
+    /**
+     * @brief Streams the SAT instance to a file if set. Is the "solver" then, and wraps the "unwrappedSolver".
+     */
+    ICNFWriter *icnfWriter;
+    std::vector<std::string> apNames;
+
+    /**
+     * @brief What is known about the formula from earlier runs, if a result cache is used. The linear searches start
+     *        after the largest bound known to be unsatisfiable, and a model from the cache is used instead of a search.
+     */
+    boost::scoped_ptr<ResultCache> resultCache;
+    std::string resultCacheKey;
+    CachedResult cachedResult;
+    bool modelFromResultCache;
 
     // General Problem Instance Variables
     int mainFormulaNumber;
 
+    /**
+     * @brief The encoding program - one instruction per subformula, in the order of the subformula numbers
+     */
+    std::vector<EncodingInstruction> encodingProgram;
+    std::vector<int> encodingChildren;
+
     // Internal functions
     void extendWordLengthBound(int newLength);
-    bool checkSatisfiabilityUnderBound();
+    void addSymmetryBreakingClauses(int newLength);
+    int allocateVariable(int subformula, int from, int to);
+    void assumeBoundFacts();
+    void analyzeFailedAssumptions();
+    void installTerminateCallback();
+    bool checkResourceLimits();
+    void reportResourceLimit(const std::string &provenFacts);
+    IncrementalSATSolver::Result checkSatisfiabilityUnderBound();
     void printSubformulaSATMapping();
     void printAPtoSATMapping();
     void printSatisfiabilityCertificate();
-    void printSimplifiedSatisfiabilityCertificate();
     void printAssignment();
-    void addTemporalOperatorsNeededForTheEncoding();
+    static void addTemporalOperatorsNeededForTheEncoding(FormulaFactory &factory);
+    void compileEncodingProgram();
+    int computeCompletenessThreshold() const;
     static void drawIntervals(std::set<std::pair<int,int> > &intervals);
+    SatisfiabilityChecker *createFreshChecker();
+    void updateResultCache(BoundSearchResult::Status status, int bound);
+    int getModelLength() const { return modelFromResultCache?cachedResult.modelLength:wordLengthBoundSoFar; }
+    void runLinear(int maxBound);
+    void runGalloping(int maxBound);
+    void runDirect(int maxBound);
 
 public:
-    SatisfiabilityChecker(int mainFormula);
+    SatisfiabilityChecker(const FormulaFactory &factory, int mainFormula, const std::string &satSolverBackend = "picosat");
     ~SatisfiabilityChecker();
-    void run(int maxBound);
+    static int prepareFormula(FormulaFactory &factory, int mainFormula, bool verbose = true, bool simplify = true, bool nativeDerivedOperators = true, const PhaseTimingCallback &timingCallback = PhaseTimingCallback());
+    void run(int maxBound, BoundStrategy strategy = BS_LINEAR);
+    IncrementalSATSolver::Result checkBound(int bound);
+    BoundSearchResult searchMinimalModel(int maxBound);
+    void printSimplifiedSatisfiabilityCertificate();
+    void setUseActivationLiterals(bool value) { useActivationLiterals = value; }
+    void setUseSymmetryBreaking(bool value);
+    void setValidateCertificates(bool value) { validateCertificates = value; }
+    void setEmitICNF(const std::string &filename);
+    void setResultCache(const std::string &directory);
+    int getNofSymmetryGenerators() const { return symmetries?symmetries->getNofGenerators():0; }
+    void setTerminateCallback(const std::function<bool()> &callback);
+    void setResourceLimits(const ResourceLimits &limits);
+
+    /**
+     * @brief Returns the name of the resource limit that has been reached ("timeout", "conflict budget", or "memory
+     *        limit"), or NULL if none has been reached
+     */
+    const char *getResourceLimitReached() const { return resourceLimitReached; }
+    bool isUnsatisfiableForLongerWords() const { return unsatisfiableForLongerWords; }
+    int getCompletenessThreshold() const { return completenessThreshold; }
+    void setProgressCallback(const std::function<void(int,IncrementalSATSolver::Result)> &callback) { progressCallback = callback; }
+    void setPhaseTimingCallback(const PhaseTimingCallback &callback) { phaseTimingCallback = callback; }
+    void setStatisticsCallback(const std::function<void(const BoundStatistics &)> &callback) { statisticsCallback = callback; }
+    std::map<std::string,std::vector<std::pair<int,int> > > getModel();
+    bool validateModel();
+    int getWordLengthBound() const { return wordLengthBoundSoFar; }
+    int getNofVariables() const { return nofVariablesSoFar; }
+    int getNofClauses() const { return nofClausesSoFar; }
 
 };
 
@@ -0,0 +1,139 @@
+#include "satSolver.hpp"
+#include <dlfcn.h>
+#include <climits>
+#include <algorithm>
+extern "C" {
+  #include "picosat.h"
+}
+
+/**
+ * @brief The PicoSAT backend
+ */
+class PicoSATSolver : public IncrementalSATSolver {
+private:
+    PicoSAT *picosat;
+    long long effortLimit; // Number of decisions, or -1 for no limit
+    unsigned long long decisionsBeforeEffortLimit;
+    std::function<bool()> terminateCallback;
+    static int interrupted(void *solver) {
+        return static_cast<PicoSATSolver*>(solver)->terminateCallback() ? 1 : 0;
+    }
+public:
+    PicoSATSolver() : effortLimit(-1), decisionsBeforeEffortLimit(0) { picosat = picosat_init(); }
+    ~PicoSATSolver() { picosat_reset(picosat); }
+    void add(int literal) { picosat_add(picosat,literal); }
+    void assume(int literal) { picosat_assume(picosat,literal); }
+    Result solve() {
+        int decisionLimit = -1;
+        if (effortLimit>=0) {
+            long long remaining = effortLimit-(long long)(picosat_decisions(picosat)-decisionsBeforeEffortLimit);
+            decisionLimit = (int)std::min(std::max(remaining,0LL),(long long)INT_MAX);
+        }
+        int picosatReturnValue = picosat_sat(picosat,decisionLimit);
+        if (picosatReturnValue==PICOSAT_SATISFIABLE) return SATISFIABLE;
+        if (picosatReturnValue==PICOSAT_UNSATISFIABLE) return UNSATISFIABLE;
+        return UNKNOWN;
+    }
+    bool getValue(int literal) { return picosat_deref(picosat,literal)==1; }
+    bool isFailedAssumption(int literal) { return picosat_failed_assumption(picosat,literal)!=0; }
+    std::string getName() { return "picosat"; }
+
+    bool setEffortLimit(long long limit) {
+        effortLimit = limit;
+        decisionsBeforeEffortLimit = picosat_decisions(picosat);
+        return true;
+    }
+
+    // PicoSAT does not count the conflicts in its API, and only reports the peak of the memory allocated
+    Statistics getStatistics() {
+        Statistics statistics;
+        statistics.decisions = picosat_decisions(picosat);
+        statistics.propagations = picosat_propagations(picosat);
+        statistics.memory = picosat_max_bytes_allocated(picosat);
+        return statistics;
+    }
+    void setTerminateCallback(const std::function<bool()> &callback) {
+        terminateCallback = callback;
+        picosat_set_interrupt(picosat,this,&interrupted);
+    }
+};
+
+/**
+ * @brief Backend for any SAT solver that implements the IPASIR interface. The solver library is loaded at runtime.
+ */
+class IPASIRSolver : public IncrementalSATSolver {
+private:
+    void *library;
+    void *solver;
+    const char *(*ipasirSignature)();
+    void *(*ipasirInit)();
+    void (*ipasirRelease)(void *);
+    void (*ipasirAdd)(void *, int);
+    void (*ipasirAssume)(void *, int);
+    int (*ipasirSolve)(void *);
+    int (*ipasirVal)(void *, int);
+    int (*ipasirFailed)(void *, int);
+    void (*ipasirSetTerminate)(void *, void *, int (*)(void *));
+    std::function<bool()> terminateCallback;
+    static int terminate(void *solver) {
+        return static_cast<IPASIRSolver*>(solver)->terminateCallback() ? 1 : 0;
+    }
+
+    template<class T> void loadFunction(T &function, const char *name) {
+        function = reinterpret_cast<T>(dlsym(library,name));
+        if (function==NULL) {
+            throw std::string("The IPASIR library does not provide the function '")+name+"'.";
+        }
+    }
+
+public:
+    IPASIRSolver(const std::string &libraryName) {
+        library = dlopen(libraryName.c_str(),RTLD_NOW | RTLD_LOCAL);
+        if (library==NULL) {
+            throw std::string("Could not load the IPASIR library '")+libraryName+"': "+dlerror();
+        }
+        try {
+            loadFunction(ipasirSignature,"ipasir_signature");
+            loadFunction(ipasirInit,"ipasir_init");
+            loadFunction(ipasirRelease,"ipasir_release");
+            loadFunction(ipasirAdd,"ipasir_add");
+            loadFunction(ipasirAssume,"ipasir_assume");
+            loadFunction(ipasirSolve,"ipasir_solve");
+            loadFunction(ipasirVal,"ipasir_val");
+            loadFunction(ipasirFailed,"ipasir_failed");
+            loadFunction(ipasirSetTerminate,"ipasir_set_terminate");
+        } catch (...) {
+            dlclose(library);
+            throw;
+        }
+        solver = ipasirInit();
+    }
+    ~IPASIRSolver() {
+        ipasirRelease(solver);
+        dlclose(library);
+    }
+    void add(int literal) { ipasirAdd(solver,literal); }
+    void assume(int literal) { ipasirAssume(solver,literal); }
+    Result solve() {
+        int returnValue = ipasirSolve(solver);
+        if (returnValue==10) return SATISFIABLE;
+        if (returnValue==20) return UNSATISFIABLE;
+        return UNKNOWN;
+    }
+    bool getValue(int literal) { return ipasirVal(solver,literal)==literal; }
+    bool isFailedAssumption(int literal) { return ipasirFailed(solver,literal)!=0; }
+    std::string getName() { return std::string("ipasir:")+ipasirSignature(); }
+    void setTerminateCallback(const std::function<bool()> &callback) {
+        terminateCallback = callback;
+        ipasirSetTerminate(solver,this,&terminate);
+    }
+};
+
+IncrementalSATSolver *IncrementalSATSolver::create(const std::string &backend) {
+    if (backend=="picosat") {
+        return new PicoSATSolver();
+    } else if (backend.substr(0,7)=="ipasir:") {
+        return new IPASIRSolver(backend.substr(7));
+    }
+    throw std::string("Unknown SAT solver backend '")+backend+"'. Supported are 'picosat' and 'ipasir:<library>'.";
+}
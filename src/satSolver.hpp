@@ -0,0 +1,64 @@
+#ifndef __SAT_SOLVER_HPP__
+#define __SAT_SOLVER_HPP__
+
+#include <string>
+#include <functional>
+
+/**
+ * @brief Interface to an incremental SAT solver. Clauses are added literal by literal and terminated by a 0, and
+ *        assumptions are only valid for the next call to "solve()", as in the PicoSAT and IPASIR interfaces.
+ */
+class IncrementalSATSolver {
+public:
+    typedef enum { SATISFIABLE = 10, UNSATISFIABLE = 20, UNKNOWN = 0 } Result;
+
+    /**
+     * @brief Counters accumulated over all calls to "solve()" so far, and the memory used by the solver in bytes. Values
+     *        that a backend does not provide are -1.
+     */
+    struct Statistics {
+        long long decisions;
+        long long conflicts;
+        long long propagations;
+        long long memory;
+        Statistics() : decisions(-1), conflicts(-1), propagations(-1), memory(-1) {}
+    };
+
+    virtual ~IncrementalSATSolver() {}
+    virtual void add(int literal) = 0;
+    virtual void assume(int literal) = 0;
+    virtual Result solve() = 0;
+
+    /**
+     * @brief Value of a literal in the model found by the last call to "solve()"
+     */
+    virtual bool getValue(int literal) = 0;
+
+    /**
+     * @brief Whether an assumption was used for proving unsatisfiability in the last call to "solve()"
+     */
+    virtual bool isFailedAssumption(int literal) = 0;
+    virtual std::string getName() = 0;
+    virtual Statistics getStatistics() { return Statistics(); }
+
+    /**
+     * @brief Limits the total search effort of all following calls to "solve()", which return UNKNOWN once the limit has
+     *        been used up. PicoSAT does not support limiting the number of conflicts, so its decisions are counted instead.
+     * @return false if the backend does not support effort limits
+     */
+    virtual bool setEffortLimit(long long) { return false; }
+
+    /**
+     * @brief Registers a function that the solver polls during "solve()". Once it returns true, the solver gives up
+     *        and "solve()" returns UNKNOWN.
+     */
+    virtual void setTerminateCallback(const std::function<bool()> &callback) = 0;
+
+    /**
+     * @brief Creates a solver for a backend description. Supported are "picosat" and "ipasir:<shared library>", where
+     *        the shared library is any SAT solver implementing the IPASIR interface.
+     */
+    static IncrementalSATSolver *create(const std::string &backend);
+};
+
+#endif
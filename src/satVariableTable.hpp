@@ -0,0 +1,85 @@
+#ifndef __SAT_VARIABLE_TABLE_HPP__
+#define __SAT_VARIABLE_TABLE_HPP__
+
+#include <vector>
+#include <cassert>
+
+/**
+ * @brief Dense table that maps from Subformula-ID (or AP-ID) x Interval-Start x Interval-End to SAT variables.
+ *
+ * Intervals are laid out in a triangular, end-point-major order: all intervals (i,j) with end point j are stored
+ * directly after those with end point j-1. Extending the word length thus only appends rows to the table, and all
+ * previously stored variables stay where they are. Every interval has one slot per atomic proposition and one slot
+ * per subformula, so the variables that belong to the same interval are next to each other.
+ *
+ * A value of 0 denotes that no SAT variable has been allocated for the respective combination.
+ */
+class SatVariableTable {
+private:
+    int nofAPs;
+    int nofSlots;
+    int nofRows;
+    std::vector<int> table;
+
+public:
+    SatVariableTable() : nofAPs(0), nofSlots(0), nofRows(0) {}
+
+    /**
+     * @brief Sets up the table for the given numbers of APs and subformulas. Must be called before the first extension.
+     */
+    void init(int _nofAPs, int nofFormulas) {
+        assert(table.size()==0);
+        nofAPs = _nofAPs;
+        nofSlots = _nofAPs+nofFormulas;
+    }
+
+    /**
+     * @brief Index of the interval (from,to) in the triangular layout
+     */
+    static int getIntervalIndex(int from, int to) {
+        assert(from<=to);
+        return to*(to+1)/2+from;
+    }
+
+    /**
+     * @brief Makes room for all intervals whose end points are at most "maxTo"
+     */
+    void extend(int maxTo) {
+        if (maxTo<nofRows) return;
+        nofRows = maxTo+1;
+        table.resize(getIntervalIndex(0,nofRows)*nofSlots,0);
+    }
+
+    int getNofRows() const { return nofRows; }
+    size_t getMemoryUsage() const { return table.capacity()*sizeof(int); }
+    int getNofSlots() const { return nofSlots; }
+    int getNofAPs() const { return nofAPs; }
+
+    /**
+     * @brief Maps a subformula number (negative for APs) to its slot within an interval
+     */
+    int getSlot(int subformula) const { return subformula+nofAPs; }
+
+    /**
+     * @brief Maps a slot back to the subformula number (negative for APs)
+     */
+    int getSubformula(int slot) const { return slot-nofAPs; }
+
+    int &operator()(int subformula, int from, int to) {
+        assert(from>=0);
+        assert(to<nofRows);
+        assert((getSlot(subformula)>=0) && (getSlot(subformula)<nofSlots));
+        return table[getIntervalIndex(from,to)*nofSlots+getSlot(subformula)];
+    }
+
+    /**
+     * @brief Read-only lookup that also works for intervals beyond the current size of the table
+     * @return the SAT variable, or 0 if none has been allocated
+     */
+    int get(int subformula, int from, int to) const {
+        if ((from<0) || (from>to) || (to>=nofRows)) return 0;
+        return table[getIntervalIndex(from,to)*nofSlots+getSlot(subformula)];
+    }
+};
+
+#endif
@@ -0,0 +1,247 @@
+#include "server.hpp"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+SatisfiabilityServer::SatisfiabilityServer(int nofThreads, int _defaultMaxBound, const std::string &_defaultSatSolverBackend, bool _defaultUseActivationLiterals) : pool(nofThreads) {
+    defaultMaxBound = _defaultMaxBound;
+    defaultSatSolverBackend = _defaultSatSolverBackend;
+    defaultUseActivationLiterals = _defaultUseActivationLiterals;
+    defaultSimplifyFormula = true;
+    defaultNativeDerivedOperators = true;
+    defaultUseSymmetryBreaking = false;
+    defaultValidateModels = false;
+}
+
+void ServerSession::send(const std::string &line) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!closed) sendFunction(line);
+}
+
+/**
+ * @brief Called when the client has gone away. Cancels all of its requests and suppresses all further output.
+ */
+void ServerSession::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    for (auto it = runningRequests.begin();it!=runningRequests.end();it++) {
+        it->second->cancel();
+    }
+}
+
+void ServerSession::handleLine(const std::string &rawLine) {
+    std::string line = rawLine;
+    if ((line.size()>0) && (line[line.size()-1]=='\r')) line = line.substr(0,line.size()-1);
+    std::istringstream is(line);
+    std::string command;
+    std::string id;
+    is >> command >> id;
+    if (command=="") return;
+    if (id=="") {
+        send("ERROR No request id given");
+        return;
+    }
+
+    if (command=="CHECK") {
+        size_t separator = line.find(':');
+        if (separator==std::string::npos) {
+            send("ERROR No ':' before the formula of request "+id);
+            return;
+        }
+        size_t optionsStart = line.find(id,line.find(command)+command.size())+id.size();
+        std::string options = (optionsStart<separator)?line.substr(optionsStart,separator-optionsStart):"";
+        std::string formula = line.substr(separator+1);
+        boost::shared_ptr<ITLSatContext> context(new ITLSatContext());
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (runningRequests.count(id)>0) {
+                sendFunction("ERROR Request "+id+" is still running");
+                return;
+            }
+            runningRequests[id] = context;
+        }
+        boost::shared_ptr<ServerSession> self = shared_from_this();
+        server.pool.submit([self,id,options,formula,context]() { self->check(id,options,formula,context); });
+    } else if (command=="CANCEL") {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = runningRequests.find(id);
+        if (it==runningRequests.end()) {
+            sendFunction("ERROR No running request "+id);
+        } else {
+            it->second->cancel();
+        }
+    } else {
+        send("ERROR Unknown command '"+command+"'");
+    }
+}
+
+/**
+ * @brief Processes a CHECK request. Runs on the thread pool of the server.
+ */
+void ServerSession::check(const std::string &id, const std::string &options, const std::string &formula, boost::shared_ptr<ITLSatContext> context) {
+    auto startTime = std::chrono::steady_clock::now();
+    std::ostringstream result;
+    result << "RESULT " << id << " ";
+    try {
+        int maxBound = server.defaultMaxBound;
+        std::string satSolverBackend = server.defaultSatSolverBackend;
+        bool useActivationLiterals = server.defaultUseActivationLiterals;
+        bool simplifyFormula = server.defaultSimplifyFormula;
+        bool nativeDerivedOperators = server.defaultNativeDerivedOperators;
+        bool useSymmetryBreaking = server.defaultUseSymmetryBreaking;
+        bool validateModel = server.defaultValidateModels;
+        ResourceLimits resourceLimits = server.defaultResourceLimits;
+        std::istringstream is(options);
+        std::string option;
+        while (is >> option) {
+            if (option=="--max-bound") {
+                is >> maxBound;
+                if (is.fail() || (maxBound<1)) throw std::string("No valid number given after --max-bound");
+            } else if (option=="--activation-literals") {
+                useActivationLiterals = true;
+            } else if (option=="--symmetry-breaking") {
+                useSymmetryBreaking = true;
+            } else if (option=="--validate") {
+                validateModel = true;
+            } else if (option=="--timeout") {
+                is >> resourceLimits.timeout;
+                if (is.fail() || (resourceLimits.timeout<=0)) throw std::string("No valid number of seconds given after --timeout");
+            } else if (option=="--conflict-budget") {
+                is >> resourceLimits.conflictBudget;
+                if (is.fail() || (resourceLimits.conflictBudget<0)) throw std::string("No valid number given after --conflict-budget");
+            } else if (option=="--memory-limit") {
+                long long megabytes;
+                is >> megabytes;
+                if (is.fail() || (megabytes<1)) throw std::string("No valid number of megabytes given after --memory-limit");
+                resourceLimits.memoryLimit = megabytes*1024*1024;
+            } else if (option=="--no-simplify") {
+                simplifyFormula = false;
+            } else if (option=="--derived-operators") {
+                std::string encoding;
+                is >> encoding;
+                if (encoding=="native") {
+                    nativeDerivedOperators = true;
+                } else if (encoding=="desugar") {
+                    nativeDerivedOperators = false;
+                } else {
+                    throw std::string("No valid encoding given after --derived-operators");
+                }
+            } else if (option=="--sat-solver") {
+                is >> satSolverBackend;
+                if (is.fail()) throw std::string("No solver given after --sat-solver");
+            } else {
+                throw std::string("Did not understand option '")+option+"'";
+            }
+        }
+
+        context->setSatSolverBackend(satSolverBackend);
+        context->setUseActivationLiterals(useActivationLiterals);
+        context->setUseSymmetryBreaking(useSymmetryBreaking);
+        context->setSimplifyFormula(simplifyFormula);
+        context->setNativeDerivedOperators(nativeDerivedOperators);
+        context->setResourceLimits(resourceLimits);
+        context->setResultCacheDirectory(server.resultCacheDirectory);
+        if (context->isCancelled()) {
+            result << "cancelled";
+        } else {
+            context->parse(formula);
+            const BoundSearchResult &searchResult = context->check(maxBound);
+            if (validateModel && (searchResult.status==BoundSearchResult::SATISFIABLE) && !context->validateModel()) {
+                throw std::string("The model found does not satisfy the formula.");
+            }
+            double time = std::chrono::duration<double>(std::chrono::steady_clock::now()-startTime).count();
+            switch (searchResult.status) {
+            case BoundSearchResult::SATISFIABLE: result << "sat "; break;
+            case BoundSearchResult::NO_MODEL_UP_TO_MAX_BOUND: result << "unsat "; break;
+            case BoundSearchResult::UNSATISFIABLE: result << "unsat-all "; break;
+            case BoundSearchResult::UNKNOWN: result << "unknown "; break;
+            case BoundSearchResult::CANCELLED: result << "cancelled"; break;
+            }
+            if (searchResult.status!=BoundSearchResult::CANCELLED) {
+                result << searchResult.bound << " " << std::fixed << std::setprecision(3) << time << " " << searchResult.nofVariables << " " << searchResult.nofClauses;
+            }
+        }
+    } catch (std::string error) {
+        result << "error " << error;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    runningRequests.erase(id);
+    if (!closed) sendFunction(result.str());
+}
+
+/**
+ * @brief Reads requests from the standard input until it is closed, and waits for all of them to be answered
+ */
+void SatisfiabilityServer::serveStandardInput() {
+    boost::shared_ptr<ServerSession> session(new ServerSession(*this,[](const std::string &line) {
+        std::cout << line << std::endl;
+    }));
+    std::string line;
+    while (std::getline(std::cin,line)) {
+        session->handleLine(line);
+    }
+    pool.waitUntilIdle();
+}
+
+void SatisfiabilityServer::serveConnection(int socket) {
+    boost::shared_ptr<ServerSession> session(new ServerSession(*this,[socket](const std::string &line) {
+        std::string data = line+"\n";
+        size_t written = 0;
+        while (written<data.size()) {
+            ssize_t result = ::send(socket,data.data()+written,data.size()-written,MSG_NOSIGNAL);
+            if (result<=0) return;
+            written += result;
+        }
+    }));
+    std::string pending;
+    char buffer[4096];
+    ssize_t nofBytes;
+    while ((nofBytes = read(socket,buffer,sizeof(buffer)))>0) {
+        pending.append(buffer,nofBytes);
+        size_t lineEnd;
+        while ((lineEnd = pending.find('\n'))!=std::string::npos) {
+            session->handleLine(pending.substr(0,lineEnd));
+            pending = pending.substr(lineEnd+1);
+        }
+    }
+    session->close();
+    ::close(socket);
+}
+
+/**
+ * @brief Accepts clients on a Unix domain socket. Every client is served by a thread of its own, while the requests of
+ *        all clients share the thread pool. Runs until the process is terminated.
+ */
+void SatisfiabilityServer::serveSocket(const std::string &socketPath) {
+    struct sockaddr_un address;
+    if (socketPath.size()>=sizeof(address.sun_path)) {
+        throw std::string("The socket path '")+socketPath+"' is too long.";
+    }
+    int listeningSocket = socket(AF_UNIX,SOCK_STREAM,0);
+    if (listeningSocket<0) throw std::string("Cannot create a socket.");
+    memset(&address,0,sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path,socketPath.c_str());
+    unlink(socketPath.c_str());
+    if (bind(listeningSocket,(struct sockaddr*)&address,sizeof(address))!=0) {
+        ::close(listeningSocket);
+        throw std::string("Cannot bind to the socket '")+socketPath+"'.";
+    }
+    if (listen(listeningSocket,16)!=0) {
+        ::close(listeningSocket);
+        throw std::string("Cannot listen on the socket '")+socketPath+"'.";
+    }
+    std::cerr << "Listening on " << socketPath << std::endl;
+    while (true) {
+        int connection = accept(listeningSocket,NULL,NULL);
+        if (connection<0) continue;
+        std::thread(&SatisfiabilityServer::serveConnection,this,connection).detach();
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef __SERVER_HPP__
+#define __SERVER_HPP__
+
+#include "threadPool.hpp"
+#include "itlsat.hpp"
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <boost/smart_ptr.hpp>
+
+class SatisfiabilityServer;
+
+/**
+ * @brief One client connection (or the standard input) of the server. Requests are line-based:
+ *
+ *        CHECK <id> [--max-bound <n>] [--activation-literals] [--sat-solver <solver>] [--no-simplify]
+ *              [--derived-operators native|desugar] [--symmetry-breaking] [--validate] [--timeout <seconds>]
+ *              [--conflict-budget <n>] [--memory-limit <MB>] : <formula>
+ *        CANCEL <id>
+ *
+ *        Every CHECK request is answered by exactly one line "RESULT <id> ..." once it has been processed, where the
+ *        result is "sat <bound> <time> <variables> <clauses>", "unsat <max bound> <time> <variables> <clauses>",
+ *        "unsat-all <bound> <time> <variables> <clauses>" (if there is no model of any length, as found at the bound),
+ *        "unknown <largest bound without a model> <time> <variables> <clauses>" (if a resource limit has been reached),
+ *        "cancelled", or "error <message>". With "--validate", a model that does not satisfy the formula is reported as an
+ *        error. Malformed lines are answered by "ERROR <message>". The timeout counts per request, but the memory limit
+ *        is compared to the memory of the whole server process, so a request can also reach it because of the other
+ *        requests running at the same time.
+ */
+class ServerSession : public boost::enable_shared_from_this<ServerSession> {
+private:
+    SatisfiabilityServer &server;
+    std::function<void(const std::string &)> sendFunction;
+    std::mutex mutex; // Protects "runningRequests" and the output
+    std::map<std::string,boost::shared_ptr<ITLSatContext> > runningRequests;
+    bool closed;
+
+    void check(const std::string &id, const std::string &options, const std::string &formula, boost::shared_ptr<ITLSatContext> context);
+
+public:
+    ServerSession(SatisfiabilityServer &_server, const std::function<void(const std::string &)> &_sendFunction) : server(_server), sendFunction(_sendFunction), closed(false) {}
+    void handleLine(const std::string &line);
+    void send(const std::string &line);
+    void close();
+};
+
+/**
+ * @brief Long-running mode that reads formulas from the standard input or from the clients connecting to a Unix domain
+ *        socket. All requests are processed on a common pool of worker threads that is kept between the requests.
+ */
+class SatisfiabilityServer {
+private:
+    WorkStealingThreadPool pool;
+    int defaultMaxBound;
+    std::string defaultSatSolverBackend;
+    bool defaultUseActivationLiterals;
+    bool defaultSimplifyFormula;
+    bool defaultNativeDerivedOperators;
+    bool defaultUseSymmetryBreaking;
+    bool defaultValidateModels;
+    ResourceLimits defaultResourceLimits;
+    std::string resultCacheDirectory;
+    friend class ServerSession;
+
+    void serveConnection(int socket);
+
+public:
+    SatisfiabilityServer(int nofThreads, int defaultMaxBound, const std::string &defaultSatSolverBackend, bool defaultUseActivationLiterals);
+    void setDefaultSimplifyFormula(bool value) { defaultSimplifyFormula = value; }
+    void setDefaultNativeDerivedOperators(bool value) { defaultNativeDerivedOperators = value; }
+    void setDefaultUseSymmetryBreaking(bool value) { defaultUseSymmetryBreaking = value; }
+    void setDefaultValidateModels(bool value) { defaultValidateModels = value; }
+    void setDefaultResourceLimits(const ResourceLimits &limits) { defaultResourceLimits = limits; }
+    void setResultCacheDirectory(const std::string &directory) { resultCacheDirectory = directory; }
+    void serveStandardInput();
+    void serveSocket(const std::string &socketPath);
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef __SYMBOL_TABLE_HPP__
+#define __SYMBOL_TABLE_HPP__
+
+#include <vector>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <stdint.h>
+#include <boost/smart_ptr.hpp>
+
+/**
+ * @brief Interns the identifiers read by the lexer. Every distinct identifier gets a dense number, starting from 0.
+ *
+ * Looking up an identifier does not allocate any memory: the identifier is hashed and compared directly in the input
+ * buffer of the lexer. Only the first occurrence of an identifier copies it into an arena of large character blocks,
+ * and the hash table uses open addressing with linear probing, so there is no allocation per entry either.
+ */
+class SymbolTable {
+private:
+    struct Entry {
+        const char *text;
+        uint32_t length;
+        uint32_t hash;
+    };
+    std::vector<Entry> entries;
+    std::vector<int> slots; // Entry number+1, or 0 for free slots. The size is always a power of two.
+    std::vector<boost::shared_array<char> > arenaBlocks;
+    size_t arenaBlockUsed;
+    size_t arenaBlockSize;
+
+    static const size_t DEFAULT_ARENA_BLOCK_SIZE = 65536;
+
+    static uint32_t computeHash(const char *text, size_t length) {
+        uint32_t hash = 2166136261U; // FNV-1a
+        for (size_t i=0;i<length;i++) {
+            hash = (hash ^ (unsigned char)text[i])*16777619U;
+        }
+        return hash;
+    }
+
+    const char *copyToArena(const char *text, size_t length) {
+        if ((arenaBlocks.size()==0) || (arenaBlockUsed+length>arenaBlockSize)) {
+            arenaBlockSize = std::max(DEFAULT_ARENA_BLOCK_SIZE,length);
+            arenaBlocks.push_back(boost::shared_array<char>(new char[arenaBlockSize]));
+            arenaBlockUsed = 0;
+        }
+        char *destination = arenaBlocks.back().get()+arenaBlockUsed;
+        memcpy(destination,text,length);
+        arenaBlockUsed += length;
+        return destination;
+    }
+
+    void rehash(size_t newSize) {
+        slots.assign(newSize,0);
+        for (unsigned int i=0;i<entries.size();i++) {
+            size_t position = entries[i].hash & (newSize-1);
+            while (slots[position]!=0) position = (position+1) & (newSize-1);
+            slots[position] = i+1;
+        }
+    }
+
+public:
+    SymbolTable() : arenaBlockUsed(0), arenaBlockSize(0) { slots.resize(64,0); }
+
+    /**
+     * @brief Returns the number of the identifier, which is registered if it has not been seen before
+     */
+    int intern(const char *text, size_t length) {
+        uint32_t hash = computeHash(text,length);
+        size_t mask = slots.size()-1;
+        size_t position = hash & mask;
+        while (slots[position]!=0) {
+            const Entry &entry = entries[slots[position]-1];
+            if ((entry.hash==hash) && (entry.length==length) && (memcmp(entry.text,text,length)==0)) {
+                return slots[position]-1;
+            }
+            position = (position+1) & mask;
+        }
+        Entry entry;
+        entry.text = copyToArena(text,length);
+        entry.length = length;
+        entry.hash = hash;
+        entries.push_back(entry);
+        slots[position] = entries.size();
+        if (entries.size()*2>slots.size()) rehash(slots.size()*2);
+        return entries.size()-1;
+    }
+
+    int getNofSymbols() const { return entries.size(); }
+    std::string getString(int symbol) const { return std::string(entries[symbol].text,entries[symbol].length); }
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "symmetryDetector.hpp"
+#include <algorithm>
+#include <set>
+
+SymmetryDetector::SymmetryDetector(const FormulaFactory &_factory, int _mainFormula) : factory(_factory), mainFormula(_mainFormula) {
+    // The atomic propositions are numbered -1, -2, ...
+    for (unsigned int i=0;i<factory.getAPNrs().size();i++) aps.push_back(-1*(int)i-1);
+    if ((mainFormula<0) || (aps.size()<2)) return;
+
+    std::vector<uint64_t> apColors(aps.size(),0);
+    refine(apColors);
+
+    // Try to swap every AP with the next one of the same color. If all of these swaps are symmetries, they generate
+    // all permutations of the APs of that color.
+    for (unsigned int i=0;i<aps.size();i++) {
+        for (unsigned int j=i+1;j<aps.size();j++) {
+            if (apColors[j]!=apColors[i]) continue;
+            bool covered = false;
+            for (auto it = generators.begin();it!=generators.end();it++) {
+                if ((*it)[i]==(int)j) covered = true;
+            }
+            std::vector<int> permutation;
+            if (!covered && findPermutation(i,j,permutation) && isSymmetry(permutation)) {
+                generators.push_back(permutation);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Hash function for combining colors (the finalizer of SplitMix64)
+ */
+uint64_t SymmetryDetector::mix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30))*0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27))*0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+/**
+ * @brief Computes a new color for every AP from its old color and the structure of all subformulas that it occurs in.
+ *        The structure is summarized bottom-up (what the subformula says) and top-down (where in the main formula it
+ *        is used). Multisets are hashed as sums, so the order of the parameters does not matter.
+ */
+void SymmetryDetector::refineOneRound(std::vector<uint64_t> &apColors) const {
+    unsigned int nofFormulas = factory.getNofFormulas();
+    std::vector<uint64_t> bottomUp(nofFormulas);
+    for (unsigned int subformula=0;subformula<nofFormulas;subformula++) {
+        uint64_t hash = 0;
+        FormulaChildren children = factory.getChildren(subformula);
+        for (auto it = children.begin();it!=children.end();it++) {
+            hash += mix((*it<0)?apColors[getAPIndex(*it)]:bottomUp[*it]);
+        }
+        bottomUp[subformula] = mix(hash ^ factory.getFormulaType(subformula));
+    }
+
+    std::vector<uint64_t> topDown(nofFormulas,0);
+    std::vector<uint64_t> apContexts(aps.size(),0);
+    topDown[mainFormula] = mix(1);
+    for (int subformula=nofFormulas-1;subformula>=0;subformula--) {
+        uint64_t context = mix(topDown[subformula] ^ mix(bottomUp[subformula]));
+        FormulaChildren children = factory.getChildren(subformula);
+        for (auto it = children.begin();it!=children.end();it++) {
+            if (*it<0) {
+                apContexts[getAPIndex(*it)] += context;
+            } else {
+                topDown[*it] += context;
+            }
+        }
+    }
+
+    for (unsigned int i=0;i<aps.size();i++) {
+        apColors[i] = mix(apColors[i] ^ mix(apContexts[i]));
+    }
+}
+
+/**
+ * @brief Refines the AP colors until the number of different colors does not grow any more
+ * @return the number of different colors
+ */
+int SymmetryDetector::refine(std::vector<uint64_t> &apColors) const {
+    int nofColors = std::set<uint64_t>(apColors.begin(),apColors.end()).size();
+    while (true) {
+        refineOneRound(apColors);
+        int newNofColors = std::set<uint64_t>(apColors.begin(),apColors.end()).size();
+        if (newNofColors==nofColors) return nofColors;
+        nofColors = newNofColors;
+    }
+}
+
+/**
+ * @brief Builds a candidate permutation of the AP indices that maps "from" to "to" by individualizing them in two
+ *        copies of the coloring and refining both. As long as some color is shared by several APs, the first of them is
+ *        individualized together with an AP of the same color in the other copy (itself if possible). No backtracking
+ *        is done, so a symmetry can be missed, but every candidate found is checked by "isSymmetry" anyway.
+ */
+bool SymmetryDetector::findPermutation(int from, int to, std::vector<int> &permutation) const {
+    std::vector<uint64_t> sourceColors(aps.size(),0);
+    std::vector<uint64_t> targetColors(aps.size(),0);
+    uint64_t individualized = 1;
+    sourceColors[from] = mix(individualized);
+    targetColors[to] = mix(individualized);
+    while (true) {
+        refine(sourceColors);
+        refine(targetColors);
+        std::vector<uint64_t> sortedSource = sourceColors;
+        std::vector<uint64_t> sortedTarget = targetColors;
+        std::sort(sortedSource.begin(),sortedSource.end());
+        std::sort(sortedTarget.begin(),sortedTarget.end());
+        if (sortedSource!=sortedTarget) return false;
+
+        int nextSource = -1;
+        for (unsigned int i=0;(i<aps.size()) && (nextSource==-1);i++) {
+            if (std::count(sortedSource.begin(),sortedSource.end(),sourceColors[i])>1) nextSource = i;
+        }
+        if (nextSource==-1) {
+            permutation.assign(aps.size(),0);
+            for (unsigned int i=0;i<aps.size();i++) {
+                permutation[i] = std::find(targetColors.begin(),targetColors.end(),sourceColors[i])-targetColors.begin();
+            }
+            return true;
+        }
+        int nextTarget = nextSource;
+        if (targetColors[nextTarget]!=sourceColors[nextSource]) {
+            nextTarget = std::find(targetColors.begin(),targetColors.end(),sourceColors[nextSource])-targetColors.begin();
+        }
+        individualized++;
+        sourceColors[nextSource] = mix(sourceColors[nextSource] ^ mix(individualized));
+        targetColors[nextTarget] = mix(targetColors[nextTarget] ^ mix(individualized));
+    }
+}
+
+/**
+ * @brief Checks if applying the permutation of the APs to every subformula yields a subformula of the table, and the main
+ *        formula is mapped to itself. As the subformulas are hash-consed, the permutation then maps the formula table onto
+ *        itself.
+ */
+bool SymmetryDetector::isSymmetry(const std::vector<int> &permutation) const {
+    std::vector<int> images(factory.getNofFormulas(),FormulaFactory::NO_SUBFORMULA);
+    std::vector<int> children;
+    for (unsigned int subformula=0;subformula<factory.getNofFormulas();subformula++) {
+        FormulaChildren from = factory.getChildren(subformula);
+        children.clear();
+        for (auto it = from.begin();it!=from.end();it++) {
+            children.push_back((*it<0)?aps[permutation[getAPIndex(*it)]]:images[*it]);
+        }
+        images[subformula] = factory.findSubformula(factory.getFormulaType(subformula),children);
+        if (images[subformula]==FormulaFactory::NO_SUBFORMULA) return false;
+    }
+    return images[mainFormula]==mainFormula;
+}
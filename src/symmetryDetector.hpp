@@ -0,0 +1,44 @@
+#ifndef __SYMMETRY_DETECTOR_HPP__
+#define __SYMMETRY_DETECTOR_HPP__
+
+#include <vector>
+#include <stdint.h>
+#include "formulaFactory.hpp"
+
+/**
+ * @brief Finds permutations of the atomic propositions that map the formula to itself, such as the permutations of the
+ *        process indices in a specification of several identical processes. Every model of the formula is then mapped
+ *        to a model by such a permutation, so the SAT encoding only needs to admit one model of every orbit.
+ *
+ * The candidate permutations are found by color refinement on the formula DAG: atomic propositions get the same color
+ * if they occur in structurally identical positions. For pairs of atomic propositions of the same color, a permutation
+ * that swaps them is then built by individualizing them and refining again, and it is only kept if applying it to the
+ * formula table yields the same formulas. The formula factory is not modified, so the detection can run after
+ * "SatisfiabilityChecker::prepareFormula".
+ */
+class SymmetryDetector {
+private:
+    const FormulaFactory &factory;
+    int mainFormula;
+    std::vector<int> aps; // All atomic propositions, in the order in which their variables are compared
+    std::vector<std::vector<int> > generators; // Per generator: the image of every AP index
+
+    static int getAPIndex(int ap) { return -ap-1; }
+    static uint64_t mix(uint64_t value);
+    void refineOneRound(std::vector<uint64_t> &apColors) const;
+    int refine(std::vector<uint64_t> &apColors) const;
+    bool findPermutation(int from, int to, std::vector<int> &permutation) const;
+    bool isSymmetry(const std::vector<int> &permutation) const;
+
+public:
+    SymmetryDetector(const FormulaFactory &factory, int mainFormula);
+    const std::vector<int> &getAPs() const { return aps; }
+    unsigned int getNofGenerators() const { return generators.size(); }
+
+    /**
+     * @brief Returns the permutation of the AP indices (see "getAPs") that is the given generator
+     */
+    const std::vector<int> &getGenerator(unsigned int nr) const { return generators[nr]; }
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "threadPool.hpp"
+
+WorkStealingThreadPool::WorkStealingThreadPool(int nofThreads) {
+    if (nofThreads<1) {
+        throw std::string("The number of threads must be at least 1.");
+    }
+    nofQueuedJobs = 0;
+    nofUnfinishedJobs = 0;
+    nextQueue = 0;
+    shuttingDown = false;
+    for (int i=0;i<nofThreads;i++) {
+        queues.push_back(boost::shared_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+    for (int i=0;i<nofThreads;i++) {
+        threads.push_back(std::thread(&WorkStealingThreadPool::workerLoop,this,i));
+    }
+}
+
+/**
+ * @brief Finishes all jobs that have been submitted so far and then stops the workers
+ */
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    waitUntilIdle();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        shuttingDown = true;
+    }
+    workAvailable.notify_all();
+    for (auto it = threads.begin();it!=threads.end();it++) {
+        it->join();
+    }
+}
+
+void WorkStealingThreadPool::submit(const std::function<void()> &job) {
+    unsigned int queueNr;
+    {
+        // The job is counted before it is published, as a worker may take and finish it right away
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queueNr = nextQueue;
+        nextQueue = (nextQueue+1) % queues.size();
+        nofQueuedJobs++;
+        nofUnfinishedJobs++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[queueNr]->mutex);
+        queues[queueNr]->jobs.push_back(job);
+    }
+    workAvailable.notify_one();
+}
+
+/**
+ * @brief Blocks until all jobs submitted so far have been executed
+ */
+void WorkStealingThreadPool::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allJobsDone.wait(lock,[this]() { return nofUnfinishedJobs==0; });
+}
+
+/**
+ * @brief Takes a job from the front of the worker's own queue or, if that one is empty, from the back of the queue of
+ *        some other worker.
+ * @return false if all queues were found to be empty
+ */
+bool WorkStealingThreadPool::takeJob(unsigned int workerNr, std::function<void()> &job) {
+    for (unsigned int i=0;i<queues.size();i++) {
+        WorkerQueue &queue = *(queues[(workerNr+i) % queues.size()]);
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            if (i==0) {
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+            } else {
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::workerLoop(unsigned int workerNr) {
+    while (true) {
+        std::function<void()> job;
+        if (takeJob(workerNr,job)) {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                nofQueuedJobs--;
+            }
+            try {
+                job();
+            } catch (...) {
+                // Jobs report their own errors. The worker must survive in any case.
+            }
+            bool idle;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex);
+                nofUnfinishedJobs--;
+                idle = nofUnfinishedJobs==0;
+            }
+            if (idle) allJobsDone.notify_all();
+        } else {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            workAvailable.wait(lock,[this]() { return shuttingDown || (nofQueuedJobs>0); });
+            if (shuttingDown && (nofQueuedJobs==0)) return;
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <boost/smart_ptr.hpp>
+
+/**
+ * @brief A pool of worker threads with one job queue per worker. Jobs are distributed over the queues round-robin. A
+ *        worker takes the jobs from the front of its own queue, and when that is empty, steals jobs from the back of the
+ *        queues of the other workers. Thus, a worker that happens to get several long-running jobs does not hold up the
+ *        short ones queued behind them.
+ */
+class WorkStealingThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()> > jobs;
+    };
+    std::vector<boost::shared_ptr<WorkerQueue> > queues;
+    std::vector<std::thread> threads;
+
+    // Global state, protected by "stateMutex"
+    std::mutex stateMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allJobsDone;
+    int nofQueuedJobs; // Jobs in the queues
+    int nofUnfinishedJobs; // Jobs in the queues or being executed
+    unsigned int nextQueue;
+    bool shuttingDown;
+
+    bool takeJob(unsigned int workerNr, std::function<void()> &job);
+    void workerLoop(unsigned int workerNr);
+
+public:
+    WorkStealingThreadPool(int nofThreads);
+    ~WorkStealingThreadPool();
+    void submit(const std::function<void()> &job);
+    void waitUntilIdle();
+    int getNofThreads() const { return threads.size(); }
+};
+
+#endif